@@ -0,0 +1,205 @@
+#ifndef DEMAND_MAPPING_H
+#define DEMAND_MAPPING_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+#include "Geometry.h"
+#include "Snapshot.h"
+
+// DFTL 방식의 요구 페이징(demand-paged) 매핑
+// - L2P 테이블 전체는 NAND의 번역 페이지(translation page)에 있고, 컨트롤러 DRAM에는
+//   최근에 쓴 매핑 항목 일부(CMT, cached mapping table)와 번역 페이지 위치표(GTD)만 둠
+// - 번역 페이지 하나에는 page_size / 4개의 항목 (PPN 4바이트)
+// - 시뮬레이터는 매핑 값 자체는 MappingTable에 그대로 두고, CMT/GTD는 어떤 항목이 DRAM에 있는지와
+//   그 때문에 생기는 번역 페이지 읽기/쓰기(NAND 트래픽)만 흉내 냄
+// - 번역 페이지도 같은 NandFlash의 블록에 쓰며, NAND 페이지 메타의 LPN 자리에는
+//   논리 페이지 수 + 번역 페이지 번호를 넣어 데이터 페이지와 구분 (GC가 이 값으로 GTD를 갱신)
+
+struct DftlOptions {
+    long long cmt_entries; // CMT 항목 수 (0이면 DFTL을 끄고 L2P 전체를 DRAM에 둠)
+
+    DftlOptions() : cmt_entries(0) {}
+
+    bool enabled() const { return cmt_entries > 0; }
+};
+
+const int CMT_ENTRY_BYTES = 8; // CMT 항목 하나의 DRAM 크기 (LPN + PPN)
+
+// 명령행 인자에서 DFTL 설정을 읽음 (모르는 인자는 건너뜀)
+//   --cmt-entries N  또는  --cmt-bytes BYTES (DRAM 예산, 항목 하나에 CMT_ENTRY_BYTES 바이트)
+inline bool parse_dftl_args(int argc, char** argv, DftlOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--cmt-entries") == 0) {
+            opt.cmt_entries = std::strtoll(value, nullptr, 10); ++i;
+        } else if (std::strcmp(key, "--cmt-bytes") == 0) {
+            opt.cmt_entries = std::strtoll(value, nullptr, 10) / CMT_ENTRY_BYTES; ++i;
+        }
+    }
+    if (opt.cmt_entries < 0 || opt.cmt_entries > INT32_MAX) {
+        std::cerr << "DFTL Error: --cmt-entries must be 0..2^31-1." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 번역 페이지 번호 / 번역 페이지 수
+inline int64_t entries_per_translation_page(const Geometry& geo) { return geo.page_size / 4; }
+inline int64_t translation_pages_for(const Geometry& geo) {
+    return (geo.logical_pages() + entries_per_translation_page(geo) - 1) / entries_per_translation_page(geo);
+}
+
+// CMT: LRU 순서의 매핑 항목 캐시 (항목마다 dirty 비트)
+// - 같은 번역 페이지에 속한 dirty 항목은 번역 페이지별 연결 리스트로 묶어 두고,
+//   번역 페이지를 한 번 쓸 때 한꺼번에 clean으로 바꿈 (DFTL의 일괄 갱신)
+class CachedMappingTable {
+public:
+    CachedMappingTable(long long capacity, int64_t entries_per_tpage, int64_t num_tpages)
+        : capacity_(static_cast<int>(capacity)), entries_per_tpage_(entries_per_tpage),
+          lpn_(capacity_), dirty_(capacity_, 0), next_(capacity_, NONE), prev_(capacity_, NONE),
+          dirty_next_(capacity_, NONE),
+          dirty_head_(capacity_ > 0 ? num_tpages : 0, NONE), head_(NONE), tail_(NONE) {
+        slot_of_.reserve(capacity_);
+        for (int s = capacity_ - 1; s >= 0; --s) free_.push_back(s);
+    }
+
+    bool full() const { return free_.empty(); }
+    int capacity() const { return capacity_; }
+    int64_t tpage_of(Lpn lpn) const { return lpn / entries_per_tpage_; }
+
+    // 있으면 가장 최근으로 옮기고 true
+    bool touch(Lpn lpn) {
+        std::unordered_map<Lpn, int>::iterator it = slot_of_.find(lpn);
+        if (it == slot_of_.end()) return false;
+        unlink(it->second);
+        link_tail(it->second);
+        return true;
+    }
+
+    bool contains(Lpn lpn) const { return slot_of_.find(lpn) != slot_of_.end(); }
+
+    // 호출 전에 full()이 아니어야 함
+    void insert(Lpn lpn, bool dirty) {
+        int slot = free_.back();
+        free_.pop_back();
+        lpn_[slot] = lpn;
+        dirty_[slot] = 0;
+        link_tail(slot);
+        slot_of_[lpn] = slot;
+        if (dirty) set_dirty(slot);
+    }
+
+    // 캐시에 없으면 아무것도 하지 않음
+    void mark_dirty(Lpn lpn) {
+        std::unordered_map<Lpn, int>::iterator it = slot_of_.find(lpn);
+        if (it != slot_of_.end() && !dirty_[it->second]) set_dirty(it->second);
+    }
+
+    // 가장 오래 안 쓴 항목 (비어 있지 않아야 함)
+    Lpn lru() const { return lpn_[head_]; }
+    bool lru_dirty() const { return dirty_[head_] != 0; }
+
+    // LRU 항목을 버림 (dirty면 먼저 clean_tpage로 번역 페이지에 써 두어야 함)
+    void evict_lru() {
+        int slot = head_;
+        unlink(slot);
+        slot_of_.erase(lpn_[slot]);
+        free_.push_back(slot);
+    }
+
+    // 번역 페이지 하나에 속한 dirty 항목을 모두 clean으로 (번역 페이지를 쓴 뒤 호출)
+    void clean_tpage(int64_t tpage) {
+        int slot = dirty_head_[tpage];
+        while (slot != NONE) {
+            int next = dirty_next_[slot];
+            dirty_[slot] = 0;
+            dirty_next_[slot] = NONE;
+            slot = next;
+        }
+        dirty_head_[tpage] = NONE;
+    }
+
+    // 스냅샷: 슬롯 배열과 리스트 링크를 그대로 (LPN -> 슬롯 해시는 불러올 때 LRU 리스트를 따라 다시 만듦)
+    void save(SnapshotWriter& w) const {
+        w.put(lpn_);
+        w.put(dirty_);
+        w.put(next_);
+        w.put(prev_);
+        w.put(dirty_next_);
+        w.put(dirty_head_);
+        w.put(free_);
+        w.put_value(head_);
+        w.put_value(tail_);
+    }
+    bool load(SnapshotCursor& c) {
+        c.get_exact(lpn_);
+        c.get_exact(dirty_);
+        c.get_exact(next_);
+        c.get_exact(prev_);
+        c.get_exact(dirty_next_);
+        c.get_exact(dirty_head_);
+        c.get(free_);
+        head_ = static_cast<int>(c.value());
+        tail_ = static_cast<int>(c.value());
+        if (!c.ok()) return false;
+        slot_of_.clear();
+        for (int slot = head_; slot != NONE; slot = next_[slot]) slot_of_[lpn_[slot]] = slot;
+        return true;
+    }
+
+private:
+    static constexpr int NONE = -1;
+
+    void set_dirty(int slot) {
+        int64_t tpage = tpage_of(lpn_[slot]);
+        dirty_[slot] = 1;
+        dirty_next_[slot] = dirty_head_[tpage];
+        dirty_head_[tpage] = slot;
+    }
+
+    void link_tail(int slot) {
+        prev_[slot] = tail_;
+        next_[slot] = NONE;
+        if (tail_ != NONE) next_[tail_] = slot; else head_ = slot;
+        tail_ = slot;
+    }
+
+    void unlink(int slot) {
+        if (prev_[slot] != NONE) next_[prev_[slot]] = next_[slot]; else head_ = next_[slot];
+        if (next_[slot] != NONE) prev_[next_[slot]] = prev_[slot]; else tail_ = prev_[slot];
+        prev_[slot] = next_[slot] = NONE;
+    }
+
+    int capacity_;
+    int64_t entries_per_tpage_;
+    std::vector<Lpn> lpn_;
+    std::vector<uint8_t> dirty_;
+    std::vector<int> next_, prev_;             // LRU 리스트
+    std::vector<int> dirty_next_; // 번역 페이지별 dirty 항목 리스트 (한꺼번에만 비우므로 단방향)
+    std::vector<int> dirty_head_;
+    int head_, tail_;
+    std::vector<int> free_;
+    std::unordered_map<Lpn, int> slot_of_;
+};
+
+// DFTL로 돌릴 수 있는 규격인지 확인 (번역 페이지 표시용 LPN도 30비트 안에 들어가야 함)
+inline bool validate_dftl(const Geometry& geo, const DftlOptions& opt) {
+    if (!opt.enabled()) return true;
+    if (entries_per_translation_page(geo) < 1) {
+        std::cerr << "DFTL Error: page size must be at least 4 bytes." << std::endl;
+        return false;
+    }
+    if (geo.logical_pages() + translation_pages_for(geo) > MAX_LOGICAL_PAGES) {
+        std::cerr << "DFTL Error: logical pages plus translation pages exceed the limit of "
+                  << MAX_LOGICAL_PAGES << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#endif // DEMAND_MAPPING_H
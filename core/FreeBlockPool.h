@@ -0,0 +1,178 @@
+#ifndef FREE_BLOCK_POOL_H
+#define FREE_BLOCK_POOL_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "Snapshot.h"
+
+// 빈 블록을 꺼내는 순서
+// - FIFO      : 가장 먼저 지워진 블록부터 (기본값)
+// - MIN_ERASE : 지우기 횟수가 가장 적은 블록부터 (동적 웨어 레벨링, 같으면 블록 번호가 작은 쪽)
+enum class AllocPolicy {
+    FIFO,
+    MIN_ERASE
+};
+
+// 빈 블록(Free Block) 풀
+// - NandFlash::erase()가 넣고(push), 블록 할당이 꺼냄(pop)
+// - FIFO: 고정 크기 링 버퍼로 구현한 큐
+// - MIN_ERASE: 같은 배열을 (지우기 횟수, 블록 번호) 최소 힙으로 씀 (push/pop O(log n))
+// - 개수는 카운터로 유지하므로 "빈 블록이 몇 개인가?"는 O(1)
+// - 이미 풀에 들어있는 블록을 다시 넣는 경우(빈 블록을 또 지우는 경우)는 무시 (힙이면 키만 고침)
+class FreeBlockPool {
+public:
+    explicit FreeBlockPool(int num_blocks, AllocPolicy policy = AllocPolicy::FIFO)
+        : policy_(policy), ring_(num_blocks), in_pool_(num_blocks, 0),
+          pos_(policy == AllocPolicy::MIN_ERASE ? num_blocks : 0), key_(pos_.size(), 0),
+          head_(0), count_(0) {}
+
+    AllocPolicy policy() const { return policy_; }
+
+    // key: 블록의 지우기 횟수 (FIFO에서는 쓰지 않음)
+    bool push(int block, uint32_t key = 0) {
+        if (in_pool_[block]) {
+            if (policy_ == AllocPolicy::MIN_ERASE && key != key_[block]) {
+                key_[block] = key;
+                sift_up(pos_[block]);
+                sift_down(pos_[block]);
+            }
+            return false;
+        }
+        in_pool_[block] = 1;
+        if (policy_ == AllocPolicy::MIN_ERASE) {
+            key_[block] = key;
+            ring_[count_] = block;
+            pos_[block] = count_;
+            sift_up(count_++);
+            return true;
+        }
+        int tail = head_ + count_;
+        if (tail >= static_cast<int>(ring_.size())) tail -= static_cast<int>(ring_.size());
+        ring_[tail] = block;
+        count_++;
+        return true;
+    }
+
+    // 정책 순서상 맨 앞의 블록을 꺼냄, 풀이 비었으면 -1
+    int pop() {
+        if (count_ == 0) return -1;
+        int block;
+        if (policy_ == AllocPolicy::MIN_ERASE) {
+            block = ring_[0];
+            count_--;
+            if (count_ > 0) {
+                ring_[0] = ring_[count_];
+                pos_[ring_[0]] = 0;
+                sift_down(0);
+            }
+        } else {
+            block = ring_[head_];
+            if (++head_ == static_cast<int>(ring_.size())) head_ = 0;
+            count_--;
+        }
+        in_pool_[block] = 0;
+        return block;
+    }
+
+    // 풀을 비움 (버퍼는 재사용)
+    void clear() {
+        std::fill(in_pool_.begin(), in_pool_.end(), 0);
+        head_ = 0;
+        count_ = 0;
+    }
+
+    int size() const { return count_; }
+    bool contains(int block) const { return in_pool_[block] != 0; }
+
+    // 풀이 차지하는 메모리 (링 버퍼/힙 + 소속 플래그, 힙이면 블록별 위치와 키)
+    static long long bytes_for(int num_blocks, AllocPolicy policy = AllocPolicy::FIFO) {
+        long long per_block = sizeof(int) + sizeof(char);
+        if (policy == AllocPolicy::MIN_ERASE) per_block += sizeof(int) + sizeof(uint32_t);
+        return static_cast<long long>(num_blocks) * per_block;
+    }
+    long long metadata_bytes() const { return bytes_for(static_cast<int>(ring_.size()), policy_); }
+
+    // 스냅샷: 정책과 내부 배열을 그대로 저장 (같은 정책으로 불러오면 꺼내는 순서까지 같음)
+    void save(SnapshotWriter& w) const {
+        w.put_value(static_cast<int64_t>(policy_));
+        w.put_value(head_);
+        w.put_value(count_);
+        w.put(ring_);
+        w.put(key_);
+    }
+
+    // 저장할 때와 정책이 다르면 풀에 있던 블록을 저장된 순서대로 다시 넣음 (erase_counts: 블록별 지우기 횟수)
+    bool load(SnapshotCursor& c, const uint32_t* erase_counts) {
+        AllocPolicy saved = static_cast<AllocPolicy>(c.value());
+        int64_t head = c.value(), count = c.value();
+        std::vector<int> ring;
+        std::vector<uint32_t> key;
+        c.get(ring);
+        c.get(key);
+        const int n = static_cast<int>(ring_.size());
+        if (!c.ok() || static_cast<int>(ring.size()) != n || head < 0 || head >= (n > 0 ? n : 1) || count < 0 || count > n) {
+            return false;
+        }
+        clear();
+        for (int64_t i = 0; i < count; ++i) {
+            int64_t at = saved == AllocPolicy::FIFO ? (head + i) % n : i;
+            int block = ring[at];
+            if (block < 0 || block >= n || in_pool_[block]) return false;
+            if (saved == policy_ && saved == AllocPolicy::FIFO) {
+                in_pool_[block] = 1; // FIFO는 링을 그대로 복원
+            } else {
+                push(block, erase_counts[block]);
+            }
+        }
+        if (saved == policy_ && saved == AllocPolicy::FIFO) {
+            ring_ = ring;
+            head_ = static_cast<int>(head);
+            count_ = static_cast<int>(count);
+        }
+        return true;
+    }
+
+private:
+    bool less(int a, int b) const {
+        return key_[a] != key_[b] ? key_[a] < key_[b] : a < b;
+    }
+
+    void sift_up(int i) {
+        int block = ring_[i];
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!less(block, ring_[parent])) break;
+            ring_[i] = ring_[parent];
+            pos_[ring_[i]] = i;
+            i = parent;
+        }
+        ring_[i] = block;
+        pos_[block] = i;
+    }
+
+    void sift_down(int i) {
+        int block = ring_[i];
+        while (true) {
+            int child = 2 * i + 1;
+            if (child >= count_) break;
+            if (child + 1 < count_ && less(ring_[child + 1], ring_[child])) child++;
+            if (!less(ring_[child], block)) break;
+            ring_[i] = ring_[child];
+            pos_[ring_[i]] = i;
+            i = child;
+        }
+        ring_[i] = block;
+        pos_[block] = i;
+    }
+
+    AllocPolicy policy_;
+    std::vector<int> ring_;      // FIFO: 링 버퍼, MIN_ERASE: 힙 배열
+    std::vector<char> in_pool_;
+    std::vector<int> pos_;       // MIN_ERASE: 블록의 힙 위치
+    std::vector<uint32_t> key_;  // MIN_ERASE: 풀에 넣을 때의 지우기 횟수
+    int head_;  // FIFO: 다음에 꺼낼 위치
+    int count_; // 풀에 들어있는 블록 수
+};
+
+#endif // FREE_BLOCK_POOL_H
@@ -0,0 +1,804 @@
+#ifndef FTL_H
+#define FTL_H
+
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "NandFlash.h"
+#include "MappingTable.h"
+#include "VictimIndex.h"
+#include "Rng.h"
+#include "GcSchedule.h"
+#include "Hotness.h"
+#include "WriteBuffer.h"
+#include "DemandMapping.h"
+#include "HybridFtl.h"
+#include "WearLeveling.h"
+#include "Snapshot.h"
+
+// VictimPolicy::select에 넘기는 GC 시점의 상태
+// - closed   : 스트림별 닫힌 블록 인덱스 (0 = 가장 차가움). 고른 블록은 정책이 직접 꺼냄
+// - nand     : 블록 시각/지우기 횟수 조회용 (나이 기반 정책)
+// - rng      : 무작위 정책용 난수 (FTL 인스턴스마다 따로 있으므로 실행 결과가 재현됨)
+// - examined : 정책이 이번 선택에서 살펴본 후보 수 (GC CPU 비용 지표)
+struct VictimContext {
+    std::vector<VictimIndex>& closed;
+    const NandFlash& nand;
+    Rng& rng;
+    long long examined;
+};
+
+// FTL 인스턴스 설정 (템플릿 정책 조합과 별개로 실행 시간에 정하는 값)
+struct FtlParams {
+    uint64_t gc_seed;  // 무작위 희생양 정책(d-choices)이 쓰는 난수 시드
+    GcSchedule gc;     // GC를 언제 얼마나 할지 (GcSchedule.h)
+    int host_streams;  // 호스트가 스트림 힌트로 쓰는 스트림 수 (HostHintClassifier)
+    HotnessOptions hotness; // 감쇠 온도 추적기 설정 (HotnessClassifier)
+    WriteBufferOptions buffer; // FTL 앞단 쓰기 버퍼 설정 (BufferedFtl, FTL 자신은 쓰지 않음)
+    DftlOptions dftl;  // 요구 페이징 매핑 (DemandMapping.h, 켜면 번역 페이지 전용 스트림이 하나 늘어남)
+    HybridOptions hybrid; // 혼합 로그 블록 FTL 설정 (HybridFtl.h, 페이지 매핑 FTL은 쓰지 않음)
+    WearOptions wear;  // 빈 블록 할당 순서와 정적 웨어 레벨링 (WearLeveling.h)
+
+    FtlParams() : gc_seed(0), host_streams(4) {}
+};
+
+// 페이지 매핑 FTL 코어
+// - 세 가지 정책을 템플릿 매개변수로 받아 컴파일 시간에 조립 (런타임 분기나 가상 호출 없음)
+//   Classifier   : LPN (+ 호스트 스트림 힌트) -> 호스트 스트림 번호. 스트림 수는 실행 시간에 정해짐
+//                  (0이 가장 차가운 스트림, 번호가 클수록 뜨거움)
+//   VictimPolicy : 스트림별 닫힌 블록 인덱스들 중에서 GC 희생양을 고름
+//   Placement    : GC가 옮기는 유효 페이지를 어느 블록에 쓸지 결정
+//                  (GC_STREAMS = 1이면 GC 전용 스트림을 0번에 두고 호스트 스트림은 1번부터)
+// - DFTL 모드(params.dftl)에서는 마지막 스트림에 번역 페이지만 모아 씀
+// - 스트림마다 Active Block 하나와 닫힌 블록 인덱스 하나가 있음
+// - 정적 웨어 레벨링(params.wear)은 쓰기 경로에서 주기적으로 검사 (static_wear_level)
+// - 정책 구현은 FtlPolicies.h 참고
+template <typename Classifier, typename VictimPolicy, typename Placement>
+class Ftl {
+public:
+    // 전체 스트림 수 (GC 전용 스트림 + 호스트 스트림 + DFTL 번역 페이지 스트림)
+    static int num_streams_for(const FtlParams& params) {
+        return Placement::GC_STREAMS + Classifier::num_streams(params) + (params.dftl.enabled() ? 1 : 0);
+    }
+
+    explicit Ftl(const Geometry& geo = Geometry(), const FtlParams& params = FtlParams())
+        : nand_(geo, params.wear.alloc),
+          pages_per_block_(geo.pages_per_block),
+          num_logical_pages_(geo.logical_pages()),
+          l2p_mapping_(geo.logical_pages(), geo.pages_per_block),
+          classifier_(geo, params),
+          num_streams_(num_streams_for(params)),
+          active_(num_streams_), to_copy_(num_streams_), spare_(num_streams_),
+          gc_rng_(params.gc_seed),
+          sched_(params.gc), gc_victim_(-1), gc_cursor_(0), gc_tokens_(0),
+          translation_stream_(params.dftl.enabled() ? num_streams_ - 1 : -1),
+          entries_per_tpage_(params.dftl.enabled() ? entries_per_translation_page(geo) : 1),
+          cmt_(params.dftl.cmt_entries, entries_per_tpage_, params.dftl.enabled() ? translation_pages_for(geo) : 0),
+          gtd_(params.dftl.enabled() ? translation_pages_for(geo) : 0, PPA{-1, -1}),
+          tpage_pending_(gtd_.size(), 0),
+          wear_(params.wear), wl_next_check_(0), wl_blocks_(0), wl_pages_(0),
+          nand_writes_base_(0), user_writes_(0), user_reads_(0), user_trims_(0), gc_count_(0), victims_examined_(0),
+          cmt_hits_(0), cmt_misses_(0), translation_reads_(0), translation_writes_(0) {
+        for (int i = 0; i < nand_.num_blocks(); ++i) {
+            nand_.erase(i);
+        }
+        wl_next_check_ = nand_.get_nand_erases() + wl_period();
+        closed_.reserve(num_streams_);
+        for (int s = 0; s < num_streams_; ++s) {
+            closed_.emplace_back(nand_.num_blocks(), geo.pages_per_block);
+        }
+        // 빈 블록 풀에서 스트림마다 Active Block을 하나씩 꺼냄 (가장 뜨거운 스트림부터)
+        for (int s = num_streams_ - 1; s >= 0; --s) {
+            active_[s] = nand_.allocate_free_block();
+        }
+    }
+
+    // stream_hint: 호스트가 붙인 스트림 번호 (NVMe Directive의 Stream ID처럼, 없으면 -1)
+    // (힌트를 쓸지 말지는 Classifier가 정함)
+    bool write(Lpn lpn, int stream_hint = -1) {
+        user_writes_++;
+        classifier_.on_write(lpn, stream_hint);
+
+        // DFTL: 매핑 항목을 CMT에 올려 두고 dirty로 (미스면 번역 페이지 읽기, 쫓겨난 dirty 항목은 번역 페이지 쓰기)
+        if (dftl() && !translate(lpn, true)) {
+            std::cerr << "Write failed because a translation page could not be written." << std::endl;
+            return false;
+        }
+
+        // soft 워터마크 아래면 모드에 따라 쓰기마다 조금씩 미리 GC
+        int free_blocks = nand_.free_block_count();
+        if (free_blocks < sched_.soft_free) {
+            if (sched_.mode == GcMode::INCREMENTAL) {
+                gc_step(sched_.pages_per_write);
+            } else if (sched_.mode == GcMode::PACED) {
+                gc_tokens_ += static_cast<long long>(sched_.pages_per_write) * (sched_.soft_free - free_blocks);
+                if (gc_tokens_ > pages_per_block_) gc_tokens_ = pages_per_block_;
+                gc_tokens_ -= gc_step(static_cast<int>(gc_tokens_));
+            }
+        }
+
+        // hard 워터마크: 옮기다 만 희생양이 있으면 먼저 끝내고, 그래도 부족하면 블록 단위 GC
+        // - 희생양의 유효 페이지가 Active Block에 다 들어가지 않으면 한 번의 GC로 빈 블록이 늘지 않을 수 있음
+        //   (옮긴 만큼 다음 GC가 유리해지므로 정상) -> 블록 수만큼 GC해도 빈 블록 수가 최고치를 넘지 못하면 실패
+        // - 옮기다 만 희생양에서 한 페이지도 옮기지 못하면 (빈 페이지가 없음) 더 해 봐야 같으므로 바로 실패
+        int best_free = nand_.free_block_count();
+        int stalled = 0;
+        while (nand_.free_block_count() < sched_.hard_free) {
+            if (gc_victim_ != -1) {
+                // 남은 유효 페이지만큼 = 이 희생양까지만
+                if (gc_step(nand_.valid_pages(gc_victim_)) == 0 && gc_victim_ != -1) {
+                    std::cerr << "Write failed because the pending GC victim could not be relocated." << std::endl;
+                    print_debug_state();
+                    return false;
+                }
+            } else if (!garbage_collect()) {
+                std::cerr << "Write failed because garbage_collect failed during pre-check." << std::endl;
+                print_debug_state();
+                return false;
+            }
+            if (nand_.free_block_count() > best_free) {
+                best_free = nand_.free_block_count();
+                stalled = 0;
+            } else if (++stalled > nand_.num_blocks()) {
+                std::cerr << "Write failed because GC frees no block (hard watermark " << sched_.hard_free
+                          << " cannot be reached)." << std::endl;
+                return false;
+            }
+        }
+
+        // 정적 웨어 레벨링 검사 주기가 지났으면 차가운 블록 하나를 비움 (줄어든 빈 블록은 다음 쓰기의 GC가 채움)
+        if (wear_.static_enabled() && nand_.get_nand_erases() >= wl_next_check_ && !static_wear_level()) {
+            std::cerr << "Write failed because static wear leveling could not relocate a block." << std::endl;
+            return false;
+        }
+
+        if (l2p_mapping_.is_mapped(lpn)) {
+            invalidate(l2p_mapping_.lookup(lpn));
+        }
+
+        PPA new_ppa = {-1, -1};
+        if (!get_new_page(new_ppa, host_stream_of(lpn))) {
+            std::cerr << "Write failed because get_new_page failed." << std::endl;
+            print_debug_state();
+            return false;
+        }
+
+        nand_.write(new_ppa.block, new_ppa.page, lpn);
+        l2p_mapping_.map(lpn, new_ppa);
+        return true;
+    }
+
+    // 장치 길들이기의 순차 채우기 (Precondition.h): LPN 0 ~ 끝을 write(lpn)로 차례로 쓴 것과 같은 상태를 만듦
+    // - 쓰기 앞 검사가 할 일이 없고 처음 쓰는 LPN이면 분류기만 거쳐 스트림을 정하고,
+    //   같은 Active Block에 이어지는 LPN 묶음을 NAND(write_run)와 L2P에 한 번에 기록
+    // - DFTL, 이미 매핑된 LPN, GC/웨어 레벨링이 필요한 시점은 그 페이지만 write()로 넘김
+    bool fill_sequential() {
+        int run_block = -1, run_page = 0, run_len = 0, run_stream = -1; // 아직 NAND에 쓰지 않은 묶음
+        Lpn run_first = 0;
+        auto flush_run = [&]() -> bool {
+            if (run_len == 0) return true;
+            if (!nand_.write_run(run_block, run_first, run_len)) return false;
+            for (int i = 0; i < run_len; ++i) {
+                l2p_mapping_.map(run_first + i, PPA{run_block, run_page + i});
+            }
+            run_len = 0;
+            return true;
+        };
+        for (Lpn lpn = 0; lpn < num_logical_pages_; ++lpn) {
+            if (dftl() || l2p_mapping_.is_mapped(lpn) || !write_precheck_idle()) {
+                if (!flush_run() || !write(lpn)) return false;
+                continue;
+            }
+            user_writes_++;
+            classifier_.on_write(lpn, -1);
+            int stream = host_stream_of(lpn);
+            if (run_len > 0 && stream == run_stream && run_page + run_len < pages_per_block_) {
+                run_len++;
+                continue;
+            }
+            PPA ppa = {-1, -1};
+            if (!flush_run() || !get_new_page(ppa, stream)) return false;
+            run_block = ppa.block;
+            run_page = ppa.page;
+            run_stream = stream;
+            run_first = lpn;
+            run_len = 1;
+        }
+        return flush_run();
+    }
+
+    // TRIM(discard): [lpn, lpn + count) 구간의 페이지를 무효로 하고 매핑을 지움 (GC가 더 이상 옮기지 않음)
+    // DFTL이면 바뀐 매핑 항목을 CMT에서는 dirty로, CMT에 없으면 번역 페이지를 한 번씩만 다시 씀
+    // 시작이 논리 용량 밖이거나 count <= 0이면 아무것도 하지 않음 (통계에도 넣지 않음), 끝은 논리 용량에서 자름
+    bool trim(Lpn lpn, int count) {
+        if (lpn < 0 || lpn >= num_logical_pages_ || count <= 0) return true;
+        Lpn end = lpn + count < num_logical_pages_ ? lpn + count : num_logical_pages_;
+        user_trims_ += end - lpn;
+        for (Lpn l = lpn; l < end; ++l) {
+            if (!l2p_mapping_.is_mapped(l)) continue;
+            invalidate(l2p_mapping_.lookup(l));
+            l2p_mapping_.unmap(l);
+            if (dftl()) note_remap(l);
+        }
+        return !dftl() || flush_pending_translation();
+    }
+
+    void read(Lpn lpn) {
+        user_reads_++;
+        if (dftl()) translate(lpn, false);
+        if (l2p_mapping_.is_mapped(lpn)) {
+            PPA ppa = l2p_mapping_.lookup(lpn);
+            nand_.read(ppa.block, ppa.page);
+        }
+    }
+
+    double getWAF() const {
+        if (user_writes_ == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(nand_writes()) / user_writes_;
+    }
+
+    int64_t num_logical_pages() const { return num_logical_pages_; }
+    long long nand_writes() const { return nand_.get_nand_writes() - nand_writes_base_; }
+
+    // 통계를 0부터 다시 셈 (장치 상태는 그대로, 스냅샷에서 시작한 실행이 자기 구간만 측정할 때)
+    // NAND 쓰기 횟수는 블록 시각으로도 쓰이므로 되돌리지 않고 기준점만 옮김
+    void reset_stats() {
+        nand_writes_base_ = nand_.get_nand_writes();
+        user_writes_ = user_reads_ = user_trims_ = 0;
+        gc_count_ = victims_examined_ = 0;
+        cmt_hits_ = cmt_misses_ = translation_reads_ = translation_writes_ = 0;
+        wl_blocks_ = wl_pages_ = 0;
+    }
+
+    // 스냅샷 저장 (Snapshot.h): NAND, 빈 블록 풀, L2P, 스트림별 Active Block과 희생양 인덱스,
+    // 점진적 GC 진행 상태, GC 난수, 분류기, DFTL의 CMT/GTD, 통계
+    bool save(const char* path) const {
+        SnapshotWriter w;
+        if (!w.open(path, nand_.geometry())) return false;
+        nand_.save(w);
+        w.begin(SNAP_L2P);
+        l2p_mapping_.save(w);
+        w.begin(SNAP_FTL);
+        w.put_value(num_streams_);
+        w.put(active_);
+        w.put(scalar_state());
+        uint64_t rng_state[4];
+        gc_rng_.get_state(rng_state);
+        w.put(rng_state, 4);
+        w.begin(SNAP_CLASSIFIER);
+        w.put(Classifier::name(), std::strlen(Classifier::name()));
+        classifier_.save(w);
+        for (int s = 0; s < num_streams_; ++s) {
+            w.begin(SNAP_VICTIM_INDEX + s);
+            closed_[s].save(w);
+        }
+        if (dftl()) {
+            w.begin(SNAP_DFTL);
+            w.put_value(cmt_.capacity());
+            cmt_.save(w);
+            w.put(gtd_);
+            w.put(tpage_pending_);
+            w.put(pending_tpages_);
+        }
+        return w.close();
+    }
+
+    // 스냅샷 불러오기 (생성 직후에 호출, 규격과 DFTL 설정은 저장할 때와 같아야 함, FAILED면 인스턴스를 버려야 함)
+    // - 스트림 수가 같으면 Active Block/희생양 인덱스/GC 진행 상태까지 그대로 (분류기도 같으면 EXACT)
+    // - 스트림 수가 다르면(정책 조합이 다름) 데이터가 든 블록을 모두 닫힌 블록으로 보고
+    //   첫 페이지의 LPN이 지금 분류기에서 가는 GC 스트림의 인덱스에 넣은 뒤 Active Block을 새로 받음 (REBUILT)
+    SnapshotLoad load(const SnapshotReader& r) {
+        if (!r.matches(nand_.geometry())) return SnapshotLoad::FAILED;
+        if (r.has(SNAP_DFTL) != dftl()) {
+            std::cerr << "Snapshot Error: the snapshot was taken " << (dftl() ? "without" : "with")
+                      << " DFTL; --cmt-entries must match." << std::endl;
+            return SnapshotLoad::FAILED;
+        }
+        SnapshotCursor c = r.section(SNAP_FTL);
+        int saved_streams = static_cast<int>(c.value());
+        std::vector<int> active;
+        std::vector<int64_t> scalars;
+        uint64_t rng_state[4];
+        c.get(active);
+        c.get(scalars);
+        c.get_exact(rng_state, 4);
+        if (!c.ok() || static_cast<int>(active.size()) != saved_streams || scalars.size() != scalar_state().size()) {
+            std::cerr << "Snapshot Error: FTL state is missing or corrupt." << std::endl;
+            return SnapshotLoad::FAILED;
+        }
+        // 배열 번호로 쓰는 값은 범위를 확인 (Active Block, 옮기다 만 희생양과 그 위치)
+        bool in_range = scalars[0] >= -1 && scalars[0] < nand_.num_blocks() && scalars[1] >= 0 &&
+                        scalars[1] <= pages_per_block_;
+        for (int block : active) in_range = in_range && block >= 0 && block < nand_.num_blocks();
+        if (!in_range) {
+            std::cerr << "Snapshot Error: FTL state refers to blocks or pages outside the device." << std::endl;
+            return SnapshotLoad::FAILED;
+        }
+        if (!nand_.load(r)) return SnapshotLoad::FAILED;
+        SnapshotCursor l2p = r.section(SNAP_L2P);
+        if (!l2p_mapping_.load(l2p)) {
+            std::cerr << "Snapshot Error: mapping table does not match the device." << std::endl;
+            return SnapshotLoad::FAILED;
+        }
+        if (dftl()) {
+            SnapshotCursor d = r.section(SNAP_DFTL);
+            if (d.value() != cmt_.capacity() || !cmt_.load(d) || !d.get_exact(gtd_) || !d.get_exact(tpage_pending_) ||
+                !d.get(pending_tpages_)) {
+                std::cerr << "Snapshot Error: DFTL state does not match (--cmt-entries must be the same)." << std::endl;
+                return SnapshotLoad::FAILED;
+            }
+        }
+        restore_scalar_state(scalars);
+        gc_rng_.set_state(rng_state);
+
+        // 분류기: 이름과 설정이 같을 때만 이어 받고, 아니면 처음 상태로 시작
+        SnapshotCursor cls = r.section(SNAP_CLASSIFIER);
+        std::vector<char> name;
+        cls.get(name);
+        bool exact = cls.ok() && std::string(name.begin(), name.end()) == Classifier::name() && classifier_.load(cls);
+
+        std::vector<VictimIndex> closed;
+        if (saved_streams == num_streams_) {
+            closed = closed_;
+            for (int s = 0; s < num_streams_; ++s) {
+                SnapshotCursor v = r.section(SNAP_VICTIM_INDEX + s);
+                if (!closed[s].load(v)) {
+                    std::cerr << "Snapshot Error: victim index of stream " << s << " is missing or corrupt." << std::endl;
+                    return SnapshotLoad::FAILED;
+                }
+            }
+        }
+        if (saved_streams == num_streams_) {
+            closed_.swap(closed);
+            active_ = active;
+            return exact ? SnapshotLoad::EXACT : SnapshotLoad::REBUILT;
+        }
+        rebuild_streams();
+        return SnapshotLoad::REBUILT;
+    }
+
+    long long trimmed_pages() const { return user_trims_; }
+
+    // 호스트가 쉬는 구간 (BACKGROUND 모드에서만 동작)
+    // 빈 블록이 soft 워터마크 이상이 되거나 페이지 idle_pages개를 옮길 때까지 GC, 옮긴 페이지 수를 돌려줌
+    int idle() {
+        if (sched_.mode != GcMode::BACKGROUND) return 0;
+        int moved = 0;
+        while (nand_.free_block_count() < sched_.soft_free && moved < sched_.idle_pages) {
+            long long before = gc_count_;
+            moved += gc_step(sched_.idle_pages - moved);
+            if (gc_count_ == before && gc_victim_ == -1) break; // 더 고를 희생양이 없음
+        }
+        return moved;
+    }
+
+    const GcSchedule& gc_schedule() const { return sched_; }
+
+    // NAND 명령 기록을 켜고 끔 (타이밍 모델이 호스트 요청 하나가 만든 NAND 명령을 모을 때 사용)
+    void set_nand_op_log(std::vector<NandOp>* log) { nand_.set_op_log(log); }
+    const Geometry& geometry() const { return nand_.geometry(); }
+
+    // GC 통계: 수행 횟수, 희생양을 고르면서 살펴본 후보 수 누적
+    long long gc_count() const { return gc_count_; }
+    long long victims_examined() const { return victims_examined_; }
+
+    int num_streams() const { return num_streams_; }
+
+    // DFTL 통계: CMT 적중/미스, 번역 페이지 읽기/쓰기 (GC가 번역 페이지를 옮긴 것은 제외)
+    long long cmt_hits() const { return cmt_hits_; }
+    long long cmt_misses() const { return cmt_misses_; }
+    long long translation_reads() const { return translation_reads_; }
+    long long translation_writes() const { return translation_writes_; }
+
+    // 정적 웨어 레벨링 통계: 비운 블록 수, 옮긴 페이지 수 (옮긴 페이지는 WAF에 포함됨)
+    long long wl_blocks() const { return wl_blocks_; }
+    long long wl_pages() const { return wl_pages_; }
+    const NandFlash& nand() const { return nand_; }
+
+    // 컨트롤러 DRAM에 두는 매핑 크기 (DFTL이면 CMT + GTD, 아니면 L2P 전체)
+    static long long mapping_dram_bytes_for(const Geometry& geo, const FtlParams& params) {
+        if (!params.dftl.enabled()) return MappingTable::bytes_for(geo.logical_pages());
+        return params.dftl.cmt_entries * CMT_ENTRY_BYTES + translation_pages_for(geo) * static_cast<long long>(sizeof(uint32_t));
+    }
+
+    // 규격만으로 계산한 메타데이터 크기 (NAND arena + L2P + 스트림별 희생양 인덱스 + 분류기의 고정 메모리)
+    // (분류기가 쓰기 패턴에 따라 키우는 메모리는 포함하지 않음)
+    static long long metadata_bytes_for(const Geometry& geo, const FtlParams& params = FtlParams()) {
+        return NandFlash::bytes_for(geo, params.wear.alloc) +
+               MappingTable::bytes_for(geo.logical_pages()) +
+               Classifier::bytes_for(geo, params) +
+               num_streams_for(params) * VictimIndex::bytes_for(static_cast<int>(geo.num_blocks), geo.pages_per_block);
+    }
+
+    void print_debug_state() {
+        std::cout << "\n--- NAND FLASH DEBUG STATE ---" << std::endl;
+        for (int s = num_streams_ - 1; s >= 0; --s) {
+            std::cout << "Stream " << s << " Active Block: " << active_[s]
+                      << ", Closed Blocks: " << closed_[s].size() << std::endl;
+        }
+        std::cout << "Free Blocks Count: " << nand_.free_block_count() << std::endl;
+        std::cout << "Valid Pages: " << nand_.total_valid_pages() << " / "
+                  << static_cast<long long>(nand_.num_blocks()) * pages_per_block_ << std::endl;
+        std::cout << std::left << std::setw(8) << "Block"
+                  << std::setw(8) << "Valid"
+                  << std::setw(10) << "Invalid"
+                  << std::setw(8) << "Current"
+                  << std::setw(8) << "Erase" << std::endl;
+        std::cout << "-----------------------------------------------" << std::endl;
+        for (int i = 0; i < nand_.num_blocks(); ++i) {
+            if (nand_.valid_pages(i) > 0 || nand_.invalid_pages(i) > 0 || nand_.current_page(i) > 0 || is_active(i)) {
+                std::cout << std::left << std::setw(8) << i
+                          << std::setw(8) << nand_.valid_pages(i)
+                          << std::setw(10) << nand_.invalid_pages(i)
+                          << std::setw(8) << nand_.current_page(i)
+                          << std::setw(8) << nand_.erase_count(i) << std::endl;
+            }
+        }
+        std::cout << "-----------------------------------------------\n" << std::endl;
+    }
+
+private:
+    friend Placement;
+
+    // 호스트 쓰기가 들어갈 스트림 / GC가 옮긴 페이지가 들어갈 스트림
+    int host_stream_of(Lpn lpn) const { return Placement::GC_STREAMS + classifier_.stream_of(lpn); }
+    int gc_stream_of(Lpn lpn) const {
+        if (lpn >= num_logical_pages_) return translation_stream_; // 번역 페이지는 번역 스트림으로
+        return Placement::GC_STREAMS ? 0 : classifier_.stream_of(lpn);
+    }
+
+    bool dftl() const { return translation_stream_ >= 0; }
+
+    // 페이지를 무효로 표시 (닫힌 블록이라면 해당 인덱스의 버킷도 한 칸 올림, 후보가 아닌 인덱스는 무시)
+    void invalidate(const PPA& ppa) {
+        nand_.invalidate(ppa.block, ppa.page);
+        for (int s = 0; s < num_streams_; ++s) {
+            closed_[s].on_invalidate(ppa.block);
+        }
+    }
+
+    // 호스트 요청의 매핑 조회: CMT에 없으면 LRU 항목 하나를 내보내고(dirty면 그 번역 페이지를 씀)
+    // 해당 번역 페이지를 읽어 항목을 올림
+    bool translate(Lpn lpn, bool dirty) {
+        if (cmt_.touch(lpn)) {
+            cmt_hits_++;
+            if (dirty) cmt_.mark_dirty(lpn);
+            return true;
+        }
+        cmt_misses_++;
+        if (cmt_.full()) {
+            if (cmt_.lru_dirty() && !write_translation_page(cmt_.tpage_of(cmt_.lru()))) return false;
+            cmt_.evict_lru();
+        }
+        read_translation_page(cmt_.tpage_of(lpn));
+        cmt_.insert(lpn, dirty);
+        return true;
+    }
+
+    void read_translation_page(int64_t tpage) {
+        const PPA& ppa = gtd_[tpage];
+        if (ppa.block == -1) return; // 아직 한 번도 쓰지 않은 번역 페이지 (모든 항목이 UNMAPPED)
+        nand_.read(ppa.block, ppa.page);
+        translation_reads_++;
+    }
+
+    // 번역 페이지를 새 버전으로 다시 씀 (예전 버전을 읽어 바뀐 항목만 고친 뒤 번역 스트림에 씀)
+    // 이 번역 페이지에 속한 CMT의 dirty 항목은 모두 clean이 됨
+    bool write_translation_page(int64_t tpage) {
+        read_translation_page(tpage);
+        if (gtd_[tpage].block != -1) invalidate(gtd_[tpage]);
+        PPA new_ppa = {-1, -1};
+        if (!get_new_page(new_ppa, translation_stream_)) return false;
+        nand_.write(new_ppa.block, new_ppa.page, num_logical_pages_ + tpage);
+        gtd_[tpage] = new_ppa;
+        translation_writes_++;
+        cmt_.clean_tpage(tpage);
+        return true;
+    }
+
+    // DFTL에서 호스트 쓰기 밖(GC 이동, TRIM)에서 바뀐 매핑 항목: CMT에 있으면 dirty로,
+    // 없으면 해당 번역 페이지를 나중에 한꺼번에 갱신하도록 표시
+    void note_remap(Lpn lpn) {
+        if (cmt_.contains(lpn)) {
+            cmt_.mark_dirty(lpn);
+            return;
+        }
+        int64_t tpage = cmt_.tpage_of(lpn);
+        if (!tpage_pending_[tpage]) {
+            tpage_pending_[tpage] = 1;
+            pending_tpages_.push_back(tpage);
+        }
+    }
+
+    // 표시해 둔 번역 페이지를 한 번씩만 갱신 (GC는 희생양 하나를 지운 뒤, TRIM은 구간을 다 지운 뒤)
+    bool flush_pending_translation() {
+        for (size_t k = 0; k < pending_tpages_.size(); ++k) {
+            int64_t tpage = pending_tpages_[k];
+            tpage_pending_[tpage] = 0;
+            if (!write_translation_page(tpage)) return false;
+        }
+        pending_tpages_.clear();
+        return true;
+    }
+
+    bool is_active(int block) const {
+        for (int s = 0; s < num_streams_; ++s) {
+            if (active_[s] == block) return true;
+        }
+        return false;
+    }
+
+    // write()의 쓰기 앞 검사(점진적 GC, hard 워터마크 GC, 정적 웨어 레벨링)가 아무것도 바꾸지 않는 상태인지
+    bool write_precheck_idle() const {
+        const int free_blocks = nand_.free_block_count();
+        if (free_blocks < sched_.hard_free) return false;
+        if (free_blocks < sched_.soft_free && (sched_.mode == GcMode::INCREMENTAL || sched_.mode == GcMode::PACED)) return false;
+        return !(wear_.static_enabled() && nand_.get_nand_erases() >= wl_next_check_);
+    }
+
+    bool is_full(int block) const { return nand_.current_page(block) >= pages_per_block_; }
+
+    // 더 이상 쓰지 않는 스트림의 Active Block을 희생양 후보로 등록
+    void seal(int stream) {
+        nand_.mark_sealed(active_[stream]);
+        closed_[stream].insert(active_[stream], nand_.invalid_pages(active_[stream]));
+    }
+
+    bool get_new_page(PPA& ppa, int stream) {
+        int& active = active_[stream];
+        if (is_full(active)) {
+            seal(stream);
+            active = nand_.allocate_free_block(); // 빈 블록 풀의 할당 순서대로 (FIFO 또는 지우기 횟수 최소)
+            if (active == -1) {
+                std::cerr << "Fatal Error in get_new_page: No free block for stream " << stream << "." << std::endl;
+                return false;
+            }
+        }
+        ppa = {active, nand_.current_page(active)};
+        return true;
+    }
+
+    // 점진적 GC: 진행 중인 희생양(없으면 새로 고름)의 유효 페이지를 최대 max_pages개 옮김
+    // - 희생양은 인덱스에서 꺼낸 채로 gc_victim_/gc_cursor_에 남아 다음 호출에서 이어짐
+    //   (그 사이 호스트가 덮어써서 무효가 된 페이지는 옮기지 않음)
+    // - 옮긴 페이지는 호스트 쓰기와 같은 경로(get_new_page)로 해당 스트림의 Active Block에 씀
+    // - 유효 페이지를 다 옮긴 희생양은 바로 지움. 한 번에 여러 희생양을 처리할 수 있음
+    //   (soft 워터마크 이상이 되면 새 희생양은 고르지 않음)
+    int gc_step(int max_pages) {
+        int moved = 0;
+        while (true) {
+            if (gc_victim_ == -1) {
+                if (nand_.free_block_count() >= sched_.soft_free) break;
+                VictimContext ctx = {closed_, nand_, gc_rng_, 0};
+                gc_victim_ = VictimPolicy::select(ctx);
+                victims_examined_ += ctx.examined;
+                gc_cursor_ = 0;
+                if (gc_victim_ == -1) break;
+            }
+            for (gc_cursor_ = nand_.next_valid(gc_victim_, gc_cursor_); gc_cursor_ < pages_per_block_;
+                 gc_cursor_ = nand_.next_valid(gc_victim_, gc_cursor_ + 1)) {
+                if (moved == max_pages) return moved;
+                Lpn lpn = nand_.page_lpn(gc_victim_, gc_cursor_);
+                nand_.read(gc_victim_, gc_cursor_);
+                PPA new_ppa = {-1, -1};
+                if (!get_new_page(new_ppa, gc_stream_of(lpn))) return moved;
+                // 옮긴 원본은 무효로 표시 (희생양의 유효 페이지 수가 L2P와 어긋나지 않도록)
+                nand_.invalidate(gc_victim_, gc_cursor_);
+                copy_page(lpn, new_ppa.block);
+                moved++;
+            }
+            nand_.erase(gc_victim_);
+            gc_count_++;
+            gc_victim_ = -1;
+            if (dftl() && !flush_pending_translation()) return moved;
+            if (moved == max_pages) break;
+        }
+        return moved;
+    }
+
+    // 번역 페이지면 GTD를, 데이터 페이지면 L2P를 갱신
+    void copy_page(Lpn lpn, int block) {
+        PPA new_ppa = {block, nand_.current_page(block)};
+        nand_.write(new_ppa.block, new_ppa.page, lpn);
+        if (lpn >= num_logical_pages_) {
+            gtd_[lpn - num_logical_pages_] = new_ppa;
+            return;
+        }
+        l2p_mapping_.map(lpn, new_ppa);
+        if (dftl()) note_remap(lpn);
+    }
+
+    // 스냅샷에 넣는 스칼라 상태 (순서를 바꾸면 SNAPSHOT_VERSION을 올림)
+    std::vector<int64_t> scalar_state() const {
+        int64_t v[] = {gc_victim_, gc_cursor_, gc_tokens_, wl_next_check_, wl_blocks_, wl_pages_, nand_writes_base_,
+                       user_writes_, user_reads_, user_trims_, gc_count_, victims_examined_,
+                       cmt_hits_, cmt_misses_, translation_reads_, translation_writes_};
+        return std::vector<int64_t>(v, v + sizeof(v) / sizeof(v[0]));
+    }
+    void restore_scalar_state(const std::vector<int64_t>& v) {
+        gc_victim_ = static_cast<int>(v[0]);
+        gc_cursor_ = static_cast<int>(v[1]);
+        gc_tokens_ = v[2];
+        wl_next_check_ = v[3];
+        wl_blocks_ = v[4];
+        wl_pages_ = v[5];
+        nand_writes_base_ = v[6];
+        user_writes_ = v[7];
+        user_reads_ = v[8];
+        user_trims_ = v[9];
+        gc_count_ = v[10];
+        victims_examined_ = v[11];
+        cmt_hits_ = v[12];
+        cmt_misses_ = v[13];
+        translation_reads_ = v[14];
+        translation_writes_ = v[15];
+    }
+
+    // 다른 정책 조합의 스냅샷에서 스트림 배치를 새로 만듦 (load 참고)
+    // 저장할 때 한 페이지도 쓰지 않았던 Active Block은 새 Active Block으로 다시 쓰고, 남으면 지워서 풀로 돌려보냄
+    void rebuild_streams() {
+        for (int s = 0; s < num_streams_; ++s) closed_[s].clear();
+        gc_victim_ = -1;
+        gc_cursor_ = 0;
+        std::vector<int> unused;
+        for (int b = 0; b < nand_.num_blocks(); ++b) {
+            if (nand_.in_free_pool(b)) continue;
+            if (nand_.current_page(b) == 0) {
+                unused.push_back(b);
+                continue;
+            }
+            closed_[gc_stream_of(nand_.page_lpn(b, 0))].insert(b, nand_.invalid_pages(b));
+        }
+        for (int s = num_streams_ - 1; s >= 0; --s) {
+            if (!unused.empty()) {
+                active_[s] = unused.back();
+                unused.pop_back();
+            } else {
+                active_[s] = nand_.allocate_free_block();
+            }
+        }
+        for (size_t i = 0; i < unused.size(); ++i) nand_.erase(unused[i]);
+    }
+
+    long long wl_period() const {
+        return wear_.check_erases > 0 ? wear_.check_erases : nand_.num_blocks();
+    }
+
+    // 정적 웨어 레벨링: 데이터가 든 닫힌 블록 중 가장 적게 지운 블록이 가장 많이 지운 블록보다
+    // threshold 넘게 뒤처졌으면 유효 페이지를 GC처럼 옮기고 지움 (지운 블록은 빈 블록 풀로 돌아가 다시 쓰임)
+    // - 옮길 자리가 모자라면(빈 블록이 스트림 수 이하) 검사를 미뤄서 다음 쓰기에서 다시 봄
+    bool static_wear_level() {
+        if (nand_.free_block_count() <= num_streams_) return true;
+        wl_next_check_ = nand_.get_nand_erases() + wl_period();
+        int max_erase = 0, coldest = -1, coldest_stream = -1;
+        for (int b = 0; b < nand_.num_blocks(); ++b) {
+            int erases = nand_.erase_count(b);
+            if (erases > max_erase) max_erase = erases;
+            if (coldest != -1 && erases >= nand_.erase_count(coldest)) continue;
+            for (int s = 0; s < num_streams_; ++s) {
+                if (closed_[s].contains(b)) {
+                    coldest = b;
+                    coldest_stream = s;
+                    break;
+                }
+            }
+        }
+        if (coldest == -1 || max_erase - nand_.erase_count(coldest) <= wear_.static_threshold) return true;
+
+        closed_[coldest_stream].remove(coldest);
+        for (int i = nand_.next_valid(coldest, 0); i < pages_per_block_; i = nand_.next_valid(coldest, i + 1)) {
+            Lpn lpn = nand_.page_lpn(coldest, i);
+            nand_.read(coldest, i);
+            PPA new_ppa = {-1, -1};
+            if (!get_new_page(new_ppa, gc_stream_of(lpn))) return false;
+            nand_.invalidate(coldest, i);
+            copy_page(lpn, new_ppa.block);
+            wl_pages_++;
+        }
+        nand_.erase(coldest);
+        wl_blocks_++;
+        return !dftl() || flush_pending_translation();
+    }
+
+    bool garbage_collect() {
+        VictimContext ctx = {closed_, nand_, gc_rng_, 0};
+        int victim_idx = VictimPolicy::select(ctx);
+        victims_examined_ += ctx.examined;
+        if (victim_idx == -1) {
+            // 닫힌 블록이 하나도 없으면 GC로 빈 블록을 늘릴 방법이 없음
+            std::cerr << "GC Error: No victim block found." << std::endl;
+            return false;
+        }
+
+        // 1. 희생양 블록의 유효 페이지만 비트맵으로 훑어 (페이지, LPN, 스트림)을 모으고 스트림별로 셈
+        //    (분류기 조회는 페이지마다 한 번, 아래 복사는 모아 둔 목록을 그대로 씀)
+        std::vector<int>& to_copy = to_copy_;
+        std::fill(to_copy.begin(), to_copy.end(), 0);
+        std::vector<GcPage>& pages = gc_pages_;
+        pages.clear();
+        for (int i = nand_.next_valid(victim_idx, 0); i < pages_per_block_; i = nand_.next_valid(victim_idx, i + 1)) {
+            const Lpn lpn = nand_.page_lpn(victim_idx, i);
+            const int stream = gc_stream_of(lpn);
+            pages.push_back(GcPage{i, stream, lpn});
+            to_copy[stream]++;
+        }
+
+        // 2. Active Block에 다 들어가지 않는 스트림만 새 블록을 미리 받아둠 (가장 뜨거운 스트림부터)
+        //    (모든 스트림이 들어가면 새 블록 없이 Active Block에 "병합")
+        std::vector<int>& spare = spare_;
+        for (int s = num_streams_ - 1; s >= 0; --s) {
+            spare[s] = -1;
+            if (pages_per_block_ - nand_.current_page(active_[s]) < to_copy[s]) {
+                spare[s] = nand_.allocate_free_block();
+                if (spare[s] == -1) {
+                    std::cerr << "GC Fatal Error: Not enough free blocks for GC copy!" << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        // 3. 유효 페이지 복사 (어느 블록에 쓸지는 Placement 정책이 결정)
+        for (const GcPage& page : pages) {
+            nand_.read(victim_idx, page.page);
+            copy_page(page.lpn, Placement::next_block(*this, page.stream, spare[page.stream]));
+        }
+        nand_.erase(victim_idx);
+        gc_count_++;
+
+        for (int s = 0; s < num_streams_; ++s) {
+            if (spare[s] != -1) Placement::finish(*this, s, spare[s]);
+        }
+        return !dftl() || flush_pending_translation();
+    }
+
+    NandFlash nand_;
+    int pages_per_block_;
+    int64_t num_logical_pages_;
+    MappingTable l2p_mapping_; // LPN -> PPN 조밀 매핑 테이블 (역방향은 NAND 페이지 메타)
+    Classifier classifier_;
+
+    int num_streams_;
+    std::vector<int> active_;          // 스트림별 Active Block
+    std::vector<int> to_copy_, spare_; // GC 중 스트림별 복사 페이지 수 / 미리 받은 새 블록 (할당 재사용)
+    struct GcPage {
+        int page;
+        int stream;
+        Lpn lpn;
+    };
+    std::vector<GcPage> gc_pages_;     // GC 중 희생양의 유효 페이지 목록 (할당 재사용)
+    std::vector<VictimIndex> closed_;  // 스트림별 닫힌 블록 (GC 희생양 후보)
+    Rng gc_rng_;
+
+    GcSchedule sched_;
+    int gc_victim_;        // 점진적 GC가 옮기고 있는 희생양 (없으면 -1)
+    int gc_cursor_;        // 희생양에서 다음에 확인할 페이지
+    long long gc_tokens_;  // PACED 모드 토큰 (옮길 수 있는 페이지 수)
+
+    int translation_stream_;            // DFTL 번역 페이지 스트림 (DFTL이 아니면 -1)
+    int64_t entries_per_tpage_;
+    CachedMappingTable cmt_;
+    std::vector<PPA> gtd_;              // 번역 페이지 번호 -> 현재 위치 ({-1, -1}이면 아직 없음)
+    std::vector<uint8_t> tpage_pending_; // GC가 끝나면 다시 써야 하는 번역 페이지 표시
+    std::vector<int64_t> pending_tpages_;
+
+    WearOptions wear_;
+    long long wl_next_check_; // 다음 정적 웨어 레벨링 검사 시점 (NAND 지우기 횟수)
+    long long wl_blocks_, wl_pages_;
+
+    long long nand_writes_base_; // reset_stats 시점의 NAND 쓰기 횟수 (WAF는 그 뒤의 쓰기만 셈)
+
+    long long user_writes_;
+    long long user_reads_;
+    long long user_trims_; // TRIM한 논리 페이지 수
+    long long gc_count_;
+    long long victims_examined_;
+    long long cmt_hits_, cmt_misses_;
+    long long translation_reads_, translation_writes_;
+};
+
+#endif // FTL_H
@@ -0,0 +1,408 @@
+#ifndef FTL_POLICIES_H
+#define FTL_POLICIES_H
+
+#include <map>
+#include <vector>
+#include "Geometry.h"
+#include "VictimIndex.h"
+#include "Ftl.h"
+
+// ============================== Classifier ==============================
+// LPN을 호스트 스트림(온도) 번호로 분류
+// - static num_streams(params): 스트림 수, on_write(lpn, hint): 호스트 쓰기마다 호출, stream_of(lpn): 현재 스트림
+// - static bytes_for(geo, params): 규격만으로 정해지는 메모리 (쓰기에 따라 늘어나는 메모리는 제외)
+// - static name(), save(w), load(cursor): 스냅샷 (load는 설정이 맞지 않으면 상태를 건드리지 않고 false)
+
+// 온도 구분 없음: 모든 데이터가 Active Block 하나로 감
+struct SingleStreamClassifier {
+    static int num_streams(const FtlParams&) { return 1; }
+    static long long bytes_for(const Geometry&, const FtlParams&) { return 0; }
+
+    SingleStreamClassifier(const Geometry&, const FtlParams&) {}
+    void on_write(Lpn, int) {}
+    int stream_of(Lpn) const { return 0; }
+
+    static const char* name() { return "none"; }
+    void save(SnapshotWriter&) const {}
+    bool load(SnapshotCursor&) { return true; }
+};
+
+// LPN별 누적 쓰기 횟수가 threshold(--hot-threshold, 기본값 11) 이상이면 Hot(1), 아니면 Cold(0)
+// (쓴 적 있는 LPN마다 맵 노드가 하나씩 늘고 횟수가 줄지 않음 -> 예전 FTL과 같은 결과를 재현하는 용도,
+//  기본값 11은 예전 FTL의 "10번 넘게 쓰면 Hot"과 같음)
+struct WriteCountClassifier {
+    static const int DEFAULT_HOT_THRESHOLD = 11;
+    static int num_streams(const FtlParams&) { return 2; }
+    static long long bytes_for(const Geometry&, const FtlParams&) { return 0; }
+
+    WriteCountClassifier(const Geometry&, const FtlParams& params)
+        : threshold_(params.hotness.threshold_or(DEFAULT_HOT_THRESHOLD)) {}
+    void on_write(Lpn lpn, int) { lpn_write_counts_[lpn]++; }
+    int stream_of(Lpn lpn) const {
+        std::map<Lpn, int>::const_iterator it = lpn_write_counts_.find(lpn);
+        return (it != lpn_write_counts_.end() && it->second >= threshold_) ? 1 : 0;
+    }
+
+    // 맵은 (LPN 배열, 횟수 배열) 두 필드로 저장 (LPN 순서이므로 불러올 때 끝에 붙이기만 함)
+    static const char* name() { return "write-count"; }
+    void save(SnapshotWriter& w) const {
+        std::vector<int64_t> lpns;
+        std::vector<int32_t> counts;
+        lpns.reserve(lpn_write_counts_.size());
+        counts.reserve(lpn_write_counts_.size());
+        for (std::map<Lpn, int>::const_iterator it = lpn_write_counts_.begin(); it != lpn_write_counts_.end(); ++it) {
+            lpns.push_back(it->first);
+            counts.push_back(it->second);
+        }
+        w.put(lpns);
+        w.put(counts);
+    }
+    bool load(SnapshotCursor& c) {
+        std::vector<int64_t> lpns;
+        std::vector<int32_t> counts;
+        c.get(lpns);
+        c.get(counts);
+        if (!c.ok() || lpns.size() != counts.size()) return false;
+        lpn_write_counts_.clear();
+        for (size_t i = 0; i < lpns.size(); ++i) {
+            lpn_write_counts_.insert(lpn_write_counts_.end(), std::make_pair(lpns[i], counts[i]));
+        }
+        return true;
+    }
+
+private:
+    int threshold_;
+    std::map<Lpn, int> lpn_write_counts_;
+};
+
+// 호스트가 쓰기마다 붙여 보낸 스트림 힌트를 그대로 따름 (NVMe Directive Streams 방식)
+// - LPN별로 마지막 힌트를 1바이트씩 기억해서 GC가 옮길 때도 같은 스트림으로 보냄
+// - 힌트가 없거나(-1) 범위를 벗어나면 0 ~ host_streams-1 로 잘라냄
+struct HostHintClassifier {
+    static int num_streams(const FtlParams& params) { return params.host_streams; }
+    static long long bytes_for(const Geometry& geo, const FtlParams&) { return geo.logical_pages(); }
+
+    HostHintClassifier(const Geometry& geo, const FtlParams& params)
+        : last_(params.host_streams - 1), hint_of_(geo.logical_pages(), 0) {}
+    void on_write(Lpn lpn, int hint) {
+        hint_of_[lpn] = static_cast<uint8_t>(hint < 0 ? 0 : (hint > last_ ? last_ : hint));
+    }
+    int stream_of(Lpn lpn) const { return hint_of_[lpn]; }
+
+    // 호스트 스트림 수가 다르면 범위를 벗어난 힌트를 잘라냄
+    static const char* name() { return "host"; }
+    void save(SnapshotWriter& w) const { w.put(hint_of_); }
+    bool load(SnapshotCursor& c) {
+        std::vector<uint8_t> hints(hint_of_.size());
+        if (!c.get_exact(hints)) return false;
+        for (size_t i = 0; i < hints.size(); ++i) {
+            if (hints[i] > last_) hints[i] = static_cast<uint8_t>(last_);
+        }
+        hint_of_.swap(hints);
+        return true;
+    }
+
+private:
+    int last_;
+    std::vector<uint8_t> hint_of_;
+};
+
+// 고정 메모리 감쇠 온도 추적기(Hotness.h)의 추정값이 threshold(기본값 4) 이상이면 Hot(1), 아니면 Cold(0)
+// - 분류는 비트 연산 몇 번이라 GC가 페이지마다 불러도 부담이 없음
+// - 카운터가 주기적으로 절반이 되므로 옮겨가는 Hot Zone을 따라감
+template <typename Tracker>
+struct HotnessClassifier {
+    static const int DEFAULT_HOT_THRESHOLD = 4;
+    static int num_streams(const FtlParams&) { return 2; }
+    static long long bytes_for(const Geometry& geo, const FtlParams& params) {
+        return Tracker::bytes_for(geo, params.hotness);
+    }
+
+    HotnessClassifier(const Geometry& geo, const FtlParams& params)
+        : tracker_(geo, params.hotness), threshold_(params.hotness.threshold_or(DEFAULT_HOT_THRESHOLD)) {}
+    void on_write(Lpn lpn, int) { tracker_.record(lpn); }
+    int stream_of(Lpn lpn) const { return tracker_.estimate(lpn) >= threshold_ ? 1 : 0; }
+
+    static const char* name() { return Tracker::name(); }
+    void save(SnapshotWriter& w) const { tracker_.save(w); }
+    bool load(SnapshotCursor& c) { return tracker_.load(c); }
+
+private:
+    Tracker tracker_;
+    int threshold_;
+};
+
+typedef HotnessClassifier<DecayingCounterTracker> DecayingCounterClassifier;
+typedef HotnessClassifier<CountMinTracker> CountMinClassifier;
+
+// ============================== VictimPolicy ==============================
+// ctx.closed(스트림별 닫힌 블록 인덱스, 0 = 가장 차가움)에서 희생양을 꺼냄, 없으면 -1
+// 살펴본 후보 수를 ctx.examined에 더함 (GC CPU 비용 비교용)
+
+// 모든 스트림을 통틀어 invalid 페이지가 가장 많은 블록 (같으면 차가운 스트림 우선)
+// (후보들의 invalid가 모두 0이면 0번 버킷에 가장 먼저 들어온 블록이 선택됨)
+struct GreedyVictim {
+    static int select(VictimContext& ctx) {
+        std::vector<VictimIndex>& closed = ctx.closed;
+        int best = -1;
+        int best_invalid = -1;
+        for (size_t s = 0; s < closed.size(); ++s) {
+            int invalid = closed[s].max_invalid();
+            ctx.examined++;
+            if (invalid > best_invalid) {
+                best_invalid = invalid;
+                best = static_cast<int>(s);
+            }
+        }
+        return best == -1 ? -1 : closed[best].pop_max();
+    }
+};
+
+// 뜨거운 스트림부터 invalid 최대 블록을 찾고, 지울 게 없으면 가장 오래된 블록 (차가운 스트림부터)
+struct HotFirstVictim {
+    static int select(VictimContext& ctx) {
+        std::vector<VictimIndex>& closed = ctx.closed;
+        for (int s = static_cast<int>(closed.size()) - 1; s >= 0; --s) {
+            ctx.examined++;
+            if (closed[s].max_invalid() > 0) return closed[s].pop_max();
+        }
+        for (size_t s = 0; s < closed.size(); ++s) {
+            if (!closed[s].empty()) return closed[s].pop_oldest();
+        }
+        return -1;
+    }
+};
+
+// 가장 뜨거운 스트림에서 가장 먼저 닫힌 블록을 우선 (지울 페이지가 하나라도 있을 때만)
+// 그 다음은 차가운 스트림부터 invalid 최대 블록, 마지막은 가장 오래된 블록 (차가운 스트림부터)
+// (invalid가 0인 블록을 고르면 빈 블록이 하나도 늘지 않아 GC가 끝나지 않을 수 있음)
+struct OldestHotVictim {
+    static int select(VictimContext& ctx) {
+        std::vector<VictimIndex>& closed = ctx.closed;
+        VictimIndex& hottest = closed.back();
+        int oldest_hot = hottest.peek_oldest();
+        ctx.examined++;
+        if (oldest_hot != -1 && hottest.invalid_of(oldest_hot) > 0) {
+            return hottest.pop_oldest();
+        }
+        for (size_t s = 0; s < closed.size(); ++s) {
+            ctx.examined++;
+            if (closed[s].max_invalid() > 0) return closed[s].pop_max();
+        }
+        for (size_t s = 0; s < closed.size(); ++s) {
+            if (!closed[s].empty()) return closed[s].pop_oldest();
+        }
+        return -1;
+    }
+};
+
+// 나이 기반 정책 공통: invalid > 0인 버킷의 머리만 점수를 매겨 최고점 블록을 꺼냄
+// - 같은 버킷(= 같은 invalid 수) 안에서는 머리가 가장 오래 안 바뀐 블록이라 나이 점수도 가장 높음
+//   (점수가 invalid 수와 나이에만 달려 있을 때만 성립: Cost-Benefit은 되지만 CAT은 select_best_scan)
+//   -> 블록 수와 관계없이 선택 비용이 스트림 수 x pages_per_block
+// - Score(nand, block, now)는 클수록 좋은 점수를 돌려줌 (같으면 차가운 스트림/적은 invalid 쪽 우선)
+// - 지울 페이지가 있는 후보가 없으면 Greedy로 넘김
+template <typename Score>
+int select_best_bucket_head(VictimContext& ctx) {
+    std::vector<VictimIndex>& closed = ctx.closed;
+    const long long now = ctx.nand.now();
+    int best = -1;
+    int best_stream = -1;
+    double best_score = -1.0;
+    for (size_t s = 0; s < closed.size(); ++s) {
+        for (int b = 1; b < closed[s].num_buckets(); ++b) {
+            int block = closed[s].bucket_head(b);
+            if (block == -1) continue;
+            ctx.examined++;
+            double score = Score::of(ctx.nand, block, now);
+            if (score > best_score) {
+                best_score = score;
+                best = block;
+                best_stream = static_cast<int>(s);
+            }
+        }
+    }
+    if (best == -1) return GreedyVictim::select(ctx);
+    closed[best_stream].remove(best);
+    return best;
+}
+
+// Cost-Benefit (LFS): (1 - u) * age / (1 + u) 최대
+// u = 유효 페이지 비율, age = 블록이 마지막으로 바뀐 뒤 흐른 시간 (NAND 쓰기 횟수 단위)
+struct CostBenefitVictim {
+    struct Score {
+        static double of(const NandFlash& nand, int block, long long now) {
+            double u = static_cast<double>(nand.valid_pages(block)) / nand.pages_per_block();
+            double age = static_cast<double>(now - nand.last_modified(block) + 1);
+            return (1.0 - u) * age / (1.0 + u);
+        }
+    };
+    static int select(VictimContext& ctx) { return select_best_bucket_head<Score>(ctx); }
+};
+
+// 모든 후보에 점수를 매겨 최고점 블록을 꺼냄 (선택 비용이 후보 수에 비례)
+// - 점수가 invalid 수와 나이만으로 정해지지 않아 버킷 머리만으로는 최선을 보장할 수 없는 정책용
+// - 지울 페이지가 없는 후보는 건너뛰고, 하나도 없으면 Greedy로 넘김
+template <typename Score>
+int select_best_scan(VictimContext& ctx) {
+    std::vector<VictimIndex>& closed = ctx.closed;
+    const long long now = ctx.nand.now();
+    int best = -1;
+    int best_stream = -1;
+    double best_score = -1.0;
+    for (size_t s = 0; s < closed.size(); ++s) {
+        for (int i = 0; i < closed[s].size(); ++i) {
+            int block = closed[s].member(i);
+            if (closed[s].invalid_of(block) == 0) continue;
+            ctx.examined++;
+            double score = Score::of(ctx.nand, block, now);
+            if (score > best_score) {
+                best_score = score;
+                best = block;
+                best_stream = static_cast<int>(s);
+            }
+        }
+    }
+    if (best == -1) return GreedyVictim::select(ctx);
+    closed[best_stream].remove(best);
+    return best;
+}
+
+// Cost-Age-Times (CAT): u / ((1 - u) * age) * 지우기 횟수 최소
+// (지우기 횟수가 적은 블록을 선호해서 마모도 함께 고르게 함, 점수는 역수로 비교)
+// - 지우기 횟수는 같은 버킷 안에서도 블록마다 달라서 버킷 머리가 최선이라는 보장이 없으므로 후보 전체를 훑음
+struct CatVictim {
+    struct Score {
+        static double of(const NandFlash& nand, int block, long long now) {
+            int valid = nand.valid_pages(block);
+            if (valid == 0) return 1e300; // 복사할 페이지가 없으면 무조건 최선
+            double u = static_cast<double>(valid) / nand.pages_per_block();
+            double age = static_cast<double>(now - nand.last_modified(block) + 1);
+            return (1.0 - u) * age / (u * (nand.erase_count(block) + 1));
+        }
+    };
+    static int select(VictimContext& ctx) { return select_best_scan<Score>(ctx); }
+};
+
+// Windowed Greedy: 스트림마다 가장 먼저 닫힌 WINDOW개 블록 중 invalid 최대 (같으면 더 오래된 블록)
+// (방금 닫혀서 아직 무효화될 여지가 많은 블록은 건드리지 않음, 선택 비용은 스트림 수 x WINDOW)
+template <int WINDOW = 32>
+struct WindowedGreedyVictim {
+    static int select(VictimContext& ctx) {
+        std::vector<VictimIndex>& closed = ctx.closed;
+        int best = -1;
+        int best_stream = -1;
+        int best_invalid = 0;
+        for (size_t s = 0; s < closed.size(); ++s) {
+            int block = closed[s].peek_oldest();
+            for (int n = 0; n < WINDOW && block != -1; ++n, block = closed[s].age_next(block)) {
+                ctx.examined++;
+                if (closed[s].invalid_of(block) > best_invalid) {
+                    best_invalid = closed[s].invalid_of(block);
+                    best = block;
+                    best_stream = static_cast<int>(s);
+                }
+            }
+        }
+        if (best == -1) return GreedyVictim::select(ctx);
+        closed[best_stream].remove(best);
+        return best;
+    }
+};
+
+// Random d-choices: 전체 후보 중 무작위로 D개를 뽑아 invalid 최대 (선택 비용 O(D), 블록 수와 무관)
+template <int D = 8>
+struct DChoicesVictim {
+    static int select(VictimContext& ctx) {
+        std::vector<VictimIndex>& closed = ctx.closed;
+        int total = 0;
+        for (size_t s = 0; s < closed.size(); ++s) total += closed[s].size();
+        if (total == 0) return -1;
+
+        int best = -1;
+        int best_stream = -1;
+        int best_invalid = 0;
+        for (int n = 0; n < D; ++n) {
+            int r = static_cast<int>(ctx.rng.below(total));
+            size_t s = 0;
+            while (r >= closed[s].size()) r -= closed[s++].size();
+            int block = closed[s].member(r);
+            ctx.examined++;
+            if (closed[s].invalid_of(block) > best_invalid) {
+                best_invalid = closed[s].invalid_of(block);
+                best = block;
+                best_stream = static_cast<int>(s);
+            }
+        }
+        if (best == -1) return GreedyVictim::select(ctx);
+        closed[best_stream].remove(best);
+        return best;
+    }
+};
+
+// ============================== Placement ==============================
+// GC가 옮기는 페이지를 쓸 블록을 결정
+// - next_block(ftl, stream, spare): 다음 페이지를 쓸 블록 (spare는 Active Block에 다 들어가지 않는 스트림만 받은 새 블록, 아니면 -1)
+// - finish(ftl, stream, spare): 희생양을 지운 뒤 새 블록을 받았던 스트림마다 한 번 호출
+
+// - GC_STREAMS: GC 전용 스트림 수 (0이면 옮긴 페이지도 Classifier가 정한 호스트 스트림으로 감)
+
+// Active Block의 남은 페이지를 먼저 채우고, 꽉 차면 닫은 뒤 새 블록으로 넘어감
+struct SpillPlacement {
+    static const int GC_STREAMS = 0;
+
+    template <typename F>
+    static int next_block(F& ftl, int stream, int spare) {
+        int& active = ftl.active_[stream];
+        if (ftl.is_full(active)) {
+            ftl.seal(stream);
+            active = spare;
+        }
+        return active;
+    }
+    template <typename F>
+    static void finish(F&, int, int) {}
+};
+
+// 다 들어가지 않는 스트림의 페이지는 전부 새 블록에 쓰고,
+// 덜 찬 Active Block은 그대로 닫아서 희생양 후보로 넘긴 뒤 새 블록을 Active Block으로 삼음
+struct FreshBlockPlacement {
+    static const int GC_STREAMS = 0;
+
+    template <typename F>
+    static int next_block(F& ftl, int stream, int spare) {
+        return spare != -1 ? spare : ftl.active_[stream];
+    }
+    template <typename F>
+    static void finish(F& ftl, int stream, int spare) {
+        ftl.seal(stream);
+        ftl.active_[stream] = spare;
+    }
+};
+
+// 옮긴 페이지는 모두 GC 전용 스트림(0번)으로 모아서 새로 쓰인 호스트 데이터와 섞이지 않게 함
+// (GC에서 살아남은 데이터는 대체로 차갑기 때문, 블록 채우는 방식은 Spill과 같음)
+struct GcStreamPlacement {
+    static const int GC_STREAMS = 1;
+
+    template <typename F>
+    static int next_block(F& ftl, int stream, int spare) {
+        int& active = ftl.active_[stream];
+        if (ftl.is_full(active)) {
+            ftl.seal(stream);
+            active = spare;
+        }
+        return active;
+    }
+    template <typename F>
+    static void finish(F&, int, int) {}
+};
+
+// ============================== 기본 조합 ==============================
+
+// 예전 FTL_Greedy (hot_cold_no_consider): 온도 구분 없는 Greedy GC
+typedef Ftl<SingleStreamClassifier, GreedyVictim, FreshBlockPlacement> GreedyFtl;
+// 예전 FTL (hot_cold_consider): Hot/Cold 분리 + Hot 우선 희생양 선택
+typedef Ftl<WriteCountClassifier, HotFirstVictim, SpillPlacement> HotColdFtl;
+
+#endif // FTL_POLICIES_H
@@ -0,0 +1,105 @@
+#ifndef GC_SCHEDULE_H
+#define GC_SCHEDULE_H
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "Geometry.h"
+
+// GC를 언제, 얼마나 할지 정하는 스케줄
+// - 빈 블록이 hard 워터마크(hard_free) 아래로 내려가면 모드와 관계없이 쓰기 전에 블록 단위 GC (foreground)
+// - soft 워터마크(soft_free) 아래에서는 모드별로 미리 조금씩 GC를 해서 foreground GC를 피함
+//   FOREGROUND  : soft 워터마크 없이 지금까지처럼 hard 워터마크에서만 GC
+//   BACKGROUND  : 호스트가 쉬는 구간(idle_every번 요청마다 한 번, 페이지 idle_pages개만큼)에만 GC
+//   INCREMENTAL : 호스트 쓰기 한 번마다 유효 페이지를 최대 pages_per_write개씩 옮김
+//   PACED       : 토큰 버킷. 쓰기마다 pages_per_write x (soft - 빈 블록 수)개의 토큰을 받아
+//                 (최대 pages_per_block개까지 저장) 토큰만큼 페이지를 옮김 -> hard에 가까울수록 빨라짐
+enum class GcMode {
+    FOREGROUND,
+    BACKGROUND,
+    INCREMENTAL,
+    PACED
+};
+
+struct GcSchedule {
+    GcMode mode;
+    int hard_free;       // 이 개수보다 빈 블록이 적으면 쓰기 전에 반드시 GC
+    int soft_free;       // 이 개수보다 빈 블록이 적으면 미리 GC 시작
+    int pages_per_write; // INCREMENTAL: 쓰기당 최대 복사 페이지, PACED: 토큰 기본 충전량
+    int idle_every;      // BACKGROUND: 호스트 요청 몇 번마다 쉬는 구간이 오는지 (0이면 쉬지 않음)
+    int idle_pages;      // BACKGROUND: 쉬는 구간 한 번에 옮길 수 있는 페이지 수
+
+    GcSchedule() : mode(GcMode::FOREGROUND), hard_free(5), soft_free(12), pages_per_write(4), idle_every(1000), idle_pages(256) {}
+};
+
+inline const char* gc_mode_name(GcMode mode) {
+    switch (mode) {
+    case GcMode::FOREGROUND: return "foreground";
+    case GcMode::BACKGROUND: return "background";
+    case GcMode::INCREMENTAL: return "incremental";
+    case GcMode::PACED: return "paced";
+    }
+    return "?";
+}
+
+// 명령행 인자에서 GC 스케줄을 읽음 (모르는 인자는 건너뜀)
+//   --gc foreground|background|incremental|paced  --gc-hard N  --gc-soft N  --gc-pages N
+//   --idle-every N  --idle-pages N
+inline bool parse_gc_args(int argc, char** argv, GcSchedule& sched) {
+    bool soft_given = false;
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--gc") == 0) {
+            std::string mode = value;
+            if (mode == "foreground") sched.mode = GcMode::FOREGROUND;
+            else if (mode == "background") sched.mode = GcMode::BACKGROUND;
+            else if (mode == "incremental") sched.mode = GcMode::INCREMENTAL;
+            else if (mode == "paced") sched.mode = GcMode::PACED;
+            else {
+                std::cerr << "GC Error: unknown mode '" << mode << "' (foreground | background | incremental | paced)." << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (std::strcmp(key, "--gc-hard") == 0) {
+            sched.hard_free = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--gc-soft") == 0) {
+            sched.soft_free = std::atoi(value); ++i;
+            soft_given = true;
+        } else if (std::strcmp(key, "--gc-pages") == 0) {
+            sched.pages_per_write = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--idle-every") == 0) {
+            sched.idle_every = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--idle-pages") == 0) {
+            sched.idle_pages = std::atoi(value); ++i;
+        }
+    }
+    if (sched.hard_free < 2 || sched.pages_per_write < 1 || sched.idle_every < 0 || sched.idle_pages < 0) {
+        std::cerr << "GC Error: --gc-hard must be at least 2, --gc-pages at least 1, --idle-every and --idle-pages not negative." << std::endl;
+        return false;
+    }
+    if (!soft_given && sched.soft_free < sched.hard_free) {
+        sched.soft_free = sched.hard_free; // soft 워터마크를 주지 않았으면 hard 워터마크 아래로 내려가지 않게
+    }
+    if (sched.soft_free < sched.hard_free) {
+        std::cerr << "GC Error: --gc-soft must not be below --gc-hard." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 장치 규격으로 hard 워터마크에 닿을 수 있는지 확인
+// 빈 블록은 오버 프로비저닝 블록(물리 블록 - 논리 용량을 담는 블록)에서만 나오므로 그보다 작아야 함
+inline bool validate_gc_schedule(const Geometry& geo, const GcSchedule& sched) {
+    const int64_t data_blocks = (geo.logical_pages() + geo.pages_per_block - 1) / geo.pages_per_block;
+    const int64_t op_blocks = geo.num_blocks - data_blocks;
+    if (sched.hard_free >= op_blocks) {
+        std::cerr << "GC Error: --gc-hard " << sched.hard_free << " must be below the " << op_blocks
+                  << " over-provisioned blocks of this geometry." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#endif // GC_SCHEDULE_H
@@ -0,0 +1,81 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// 64비트 주소 타입 (TB급 장치의 수억 개 페이지도 표현 가능)
+typedef int64_t Lpn; // 논리 페이지 번호
+typedef int64_t Ppn; // 물리 페이지 번호 (block * pages_per_block + page)
+
+// 메타데이터 저장 형식의 한계
+// - NAND 페이지 메타는 4바이트 안에 상태 2비트 + LPN 30비트를 저장 -> 논리 페이지 < 2^30
+// - L2P 테이블은 PPN을 uint32_t로 저장 (0xFFFFFFFF는 UNMAPPED) -> 물리 페이지 < 2^32 - 1
+const int64_t MAX_LOGICAL_PAGES = (int64_t(1) << 30) - 1;
+const int64_t MAX_PHYSICAL_PAGES = (int64_t(1) << 32) - 1;
+
+// 장치 규격 (실행 시간에 설정)
+struct Geometry {
+    int64_t num_blocks;     // 전체 블록 개수
+    int pages_per_block;    // 블록 당 페이지 개수
+    double op_ratio;        // 오버 프로비저닝 비율: 물리 용량 중 사용자에게 보이지 않는 예비 영역
+    int page_size;          // 페이지 크기 (바이트, 트레이스/대역폭 환산용)
+
+    // 기본값은 기존 시뮬레이터와 동일 (128 블록 x 64 페이지, 논리 용량 = 물리의 75%)
+    Geometry() : num_blocks(128), pages_per_block(64), op_ratio(0.25), page_size(4096) {}
+
+    int64_t physical_pages() const { return num_blocks * pages_per_block; }
+    int64_t logical_pages() const { return static_cast<int64_t>(physical_pages() * (1.0 - op_ratio)); }
+
+    // 규격이 저장 형식의 한계 안에 있는지 확인 (문제가 있으면 이유를 출력하고 false)
+    bool validate() const {
+        if (num_blocks < 2 || pages_per_block < 1) {
+            std::cerr << "Geometry Error: need at least 2 blocks and 1 page per block." << std::endl;
+            return false;
+        }
+        if (num_blocks > INT32_MAX) {
+            std::cerr << "Geometry Error: block count must fit in 32 bits." << std::endl;
+            return false;
+        }
+        if (!(op_ratio > 0.0 && op_ratio < 1.0)) { // NaN도 거름
+            std::cerr << "Geometry Error: op_ratio must be in (0, 1)." << std::endl;
+            return false;
+        }
+        if (physical_pages() > MAX_PHYSICAL_PAGES) {
+            std::cerr << "Geometry Error: " << physical_pages() << " physical pages exceed the limit of "
+                      << MAX_PHYSICAL_PAGES << "." << std::endl;
+            return false;
+        }
+        if (logical_pages() > MAX_LOGICAL_PAGES) {
+            std::cerr << "Geometry Error: " << logical_pages() << " logical pages exceed the limit of "
+                      << MAX_LOGICAL_PAGES << "." << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+// 명령행 인자에서 장치 규격을 읽음 (모르는 인자는 건너뜀, 값이 잘못되면 false)
+//   --blocks N  --pages-per-block N  --op R  --page-size BYTES  --mem-budget-mb MB
+inline bool parse_geometry_args(int argc, char** argv, Geometry& geo, long long& mem_budget_bytes) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--blocks") == 0) {
+            geo.num_blocks = std::strtoll(value, nullptr, 10); ++i;
+        } else if (std::strcmp(key, "--pages-per-block") == 0) {
+            geo.pages_per_block = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--op") == 0) {
+            geo.op_ratio = std::atof(value); ++i;
+        } else if (std::strcmp(key, "--page-size") == 0) {
+            geo.page_size = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--mem-budget-mb") == 0) {
+            mem_budget_bytes = std::strtoll(value, nullptr, 10) * 1024 * 1024; ++i;
+        }
+    }
+    return geo.validate();
+}
+
+#endif // GEOMETRY_H
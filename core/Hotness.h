@@ -0,0 +1,222 @@
+#ifndef HOTNESS_H
+#define HOTNESS_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "Geometry.h"
+#include "Snapshot.h"
+
+// 고정 메모리 + 시간 감쇠(decay) LPN 온도 추적기
+// - 쓰기마다 record(lpn), 온도는 estimate(lpn) (0 ~ 15)
+// - decay_writes번 쓸 때마다 모든 카운터를 절반으로 줄여서 예전에 뜨거웠던 LPN도 식어감
+// - 카운터는 4비트 포화 카운터를 uint64_t 하나에 16개씩 묶어 저장 (절반 줄이기는 워드 단위 시프트+마스크)
+
+// 감쇠 주기/임계값/스케치 크기 설정
+struct HotnessOptions {
+    int threshold;          // 온도가 이 값 이상이면 Hot (0이면 분류기 기본값: write-count 11, decay / count-min 4)
+    long long decay_writes; // 카운터를 절반으로 줄이는 주기 (쓰기 횟수, 0이면 논리 페이지 수)
+    int sketch_width_log2;  // count-min 스케치 한 행의 칸 수 (2의 거듭제곱 지수, 0이면 논리 페이지 수 / 4)
+
+    HotnessOptions() : threshold(0), decay_writes(0), sketch_width_log2(0) {}
+
+    // 지정하지 않았으면 분류기 기본값
+    int threshold_or(int classifier_default) const { return threshold > 0 ? threshold : classifier_default; }
+};
+
+// 명령행 인자에서 온도 추적 설정을 읽음 (모르는 인자는 건너뜀)
+//   --hot-threshold N  --decay-writes N  --sketch-width-log2 N
+// (--hot-threshold는 주면 1 이상이어야 함: 0은 "분류기 기본값"이라는 내부 표시라 명령행에서는 받지 않음)
+// (--hot-threshold의 상한 15는 4비트 카운터를 쓰는 decay / count-min에만 해당하므로 드라이버가 분류기를 보고 검사)
+inline bool parse_hotness_args(int argc, char** argv, HotnessOptions& opt) {
+    bool threshold_given = false;
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--hot-threshold") == 0) {
+            opt.threshold = std::atoi(value); ++i;
+            threshold_given = true;
+        } else if (std::strcmp(key, "--decay-writes") == 0) {
+            opt.decay_writes = std::strtoll(value, nullptr, 10); ++i;
+        } else if (std::strcmp(key, "--sketch-width-log2") == 0) {
+            opt.sketch_width_log2 = std::atoi(value); ++i;
+        }
+    }
+    if ((threshold_given && opt.threshold < 1) || opt.decay_writes < 0 || opt.sketch_width_log2 < 0 || opt.sketch_width_log2 > 40) {
+        std::cerr << "Hotness Error: --hot-threshold must be at least 1, --decay-writes >= 0, --sketch-width-log2 0..40." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 4비트 포화 카운터 배열 (카운터 n개 = n/2 바이트)
+class NibbleCounters {
+public:
+    explicit NibbleCounters(int64_t n) : words_((n + 15) / 16, 0) {}
+
+    int get(int64_t i) const { return static_cast<int>((words_[i >> 4] >> shift(i)) & 0xF); }
+
+    // 1 증가 (15에서 멈춤), 증가 후 값을 돌려줌
+    int increment(int64_t i) {
+        uint64_t& w = words_[i >> 4];
+        int s = shift(i);
+        int v = static_cast<int>((w >> s) & 0xF);
+        if (v < 15) {
+            w += 1ull << s;
+            v++;
+        }
+        return v;
+    }
+
+    // 값을 최소 v로 올림 (count-min의 보수적 갱신용)
+    void raise_to(int64_t i, int v) {
+        uint64_t& w = words_[i >> 4];
+        int s = shift(i);
+        int cur = static_cast<int>((w >> s) & 0xF);
+        if (cur < v) w += static_cast<uint64_t>(v - cur) << s;
+    }
+
+    // 모든 카운터를 절반으로 (니블마다 오른쪽으로 1비트, 옆 니블에서 넘어온 비트는 마스크로 제거)
+    void halve_all() {
+        for (size_t k = 0; k < words_.size(); ++k) {
+            words_[k] = (words_[k] >> 1) & 0x7777777777777777ull;
+        }
+    }
+
+    long long bytes() const { return static_cast<long long>(words_.size() * sizeof(uint64_t)); }
+    void save(SnapshotWriter& w) const { w.put(words_); }
+    bool load(SnapshotCursor& c) { return c.get_exact(words_); }
+    static long long bytes_for(int64_t n) { return (n + 15) / 16 * static_cast<long long>(sizeof(uint64_t)); }
+
+private:
+    static int shift(int64_t i) { return static_cast<int>(i & 15) * 4; }
+
+    std::vector<uint64_t> words_;
+};
+
+// LPN마다 4비트 카운터 하나 (LPN당 0.5바이트, 오차 없음)
+class DecayingCounterTracker {
+public:
+    DecayingCounterTracker(const Geometry& geo, const HotnessOptions& opt)
+        : counters_(geo.logical_pages()), decay_writes_(decay_period(geo, opt)), writes_(0) {}
+
+    void record(Lpn lpn) {
+        counters_.increment(lpn);
+        if (++writes_ == decay_writes_) {
+            counters_.halve_all();
+            writes_ = 0;
+        }
+    }
+    int estimate(Lpn lpn) const { return counters_.get(lpn); }
+
+    static const char* name() { return "decay"; }
+    void save(SnapshotWriter& w) const {
+        counters_.save(w);
+        w.put_value(writes_);
+    }
+    bool load(SnapshotCursor& c) {
+        NibbleCounters counters = counters_;
+        if (!counters.load(c)) return false;
+        long long writes = c.value();
+        if (!c.ok() || writes >= decay_writes_) return false; // 감쇠 주기가 다르면 다시 시작
+        counters_ = counters;
+        writes_ = writes;
+        return true;
+    }
+
+    static long long bytes_for(const Geometry& geo, const HotnessOptions&) {
+        return NibbleCounters::bytes_for(geo.logical_pages());
+    }
+
+    static long long decay_period(const Geometry& geo, const HotnessOptions& opt) {
+        return opt.decay_writes > 0 ? opt.decay_writes : geo.logical_pages();
+    }
+
+private:
+    NibbleCounters counters_;
+    long long decay_writes_;
+    long long writes_;
+};
+
+// Count-min 스케치 (DEPTH개 행 x 2^width_log2 칸의 4비트 카운터)
+// - 메모리를 LPN 수와 따로 정할 수 있음 (기본은 LPN 4개당 한 칸 x 4행 = LPN당 0.5바이트)
+//   Hot 집합이 LPN 공간보다 훨씬 작으면 --sketch-width-log2로 줄여도 됨 (한 행의 칸 수가 Hot LPN 수보다 작으면 오분류가 급증)
+// - 보수적 갱신: 가장 작은 칸만 올리므로 충돌로 인한 과대 추정이 줄어듦
+// - 해시는 행마다 다른 홀수 상수를 곱한 뒤 상위 비트를 씀 (곱셈 한 번)
+class CountMinTracker {
+public:
+    static const int DEPTH = 4;
+
+    CountMinTracker(const Geometry& geo, const HotnessOptions& opt)
+        : width_log2_(width_log2_for(geo, opt)), counters_(static_cast<int64_t>(DEPTH) << width_log2_),
+          decay_writes_(DecayingCounterTracker::decay_period(geo, opt)), writes_(0) {}
+
+    void record(Lpn lpn) {
+        int64_t slot[DEPTH];
+        int low = 15;
+        for (int r = 0; r < DEPTH; ++r) {
+            slot[r] = index(r, lpn);
+            int v = counters_.get(slot[r]);
+            if (v < low) low = v;
+        }
+        if (low < 15) {
+            for (int r = 0; r < DEPTH; ++r) counters_.raise_to(slot[r], low + 1);
+        }
+        if (++writes_ == decay_writes_) {
+            counters_.halve_all();
+            writes_ = 0;
+        }
+    }
+
+    int estimate(Lpn lpn) const {
+        int low = 15;
+        for (int r = 0; r < DEPTH; ++r) {
+            int v = counters_.get(index(r, lpn));
+            if (v < low) low = v;
+        }
+        return low;
+    }
+
+    static const char* name() { return "count-min"; }
+    void save(SnapshotWriter& w) const {
+        counters_.save(w);
+        w.put_value(writes_);
+    }
+    bool load(SnapshotCursor& c) {
+        NibbleCounters counters = counters_;
+        if (!counters.load(c)) return false; // 스케치 폭이 다르면 크기가 달라 실패
+        long long writes = c.value();
+        if (!c.ok() || writes >= decay_writes_) return false;
+        counters_ = counters;
+        writes_ = writes;
+        return true;
+    }
+
+    static long long bytes_for(const Geometry& geo, const HotnessOptions& opt) {
+        return NibbleCounters::bytes_for(static_cast<int64_t>(DEPTH) << width_log2_for(geo, opt));
+    }
+
+private:
+    static int width_log2_for(const Geometry& geo, const HotnessOptions& opt) {
+        if (opt.sketch_width_log2 > 0) return opt.sketch_width_log2;
+        int k = 4;
+        while ((1ll << (k + 2)) < geo.logical_pages()) ++k;
+        return k;
+    }
+
+    int64_t index(int row, Lpn lpn) const {
+        static const uint64_t MUL[DEPTH] = {
+            0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull, 0xD6E8FEB86659FD93ull};
+        uint64_t h = (static_cast<uint64_t>(lpn) + 1) * MUL[row];
+        return (static_cast<int64_t>(row) << width_log2_) + static_cast<int64_t>(h >> (64 - width_log2_));
+    }
+
+    int width_log2_;
+    NibbleCounters counters_;
+    long long decay_writes_;
+    long long writes_;
+};
+
+#endif // HOTNESS_H
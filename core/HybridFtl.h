@@ -0,0 +1,417 @@
+#ifndef HYBRID_FTL_H
+#define HYBRID_FTL_H
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "NandFlash.h"
+#include "MappingTable.h"
+#include "GcSchedule.h"
+
+// 혼합(hybrid) 로그 블록 FTL
+// - 데이터 블록은 블록 단위 매핑 (논리 블록 번호 LBN -> 물리 블록, 페이지 위치는 LPN % pages_per_block 고정)
+// - 덮어쓰기는 소수의 로그 블록에 페이지 단위로 기록하고, 로그 블록이 모자라면 병합(merge)으로 데이터 블록에 되돌림
+//   BAST : 로그 블록 하나가 논리 블록 하나에만 딸림 (블록 연관)
+//   FAST : 순차 로그 블록(SW) 하나 + 모든 논리 블록이 함께 쓰는 랜덤 로그 블록(RW) 여러 개 (완전 연관)
+// - 병합 세 가지
+//   switch  : 로그 블록이 0 ~ ppb-1 페이지를 순서대로 모두 가짐 -> 로그 블록이 그대로 데이터 블록이 됨 (복사 없음)
+//   partial : 앞쪽 k 페이지만 순서대로 가짐 -> 나머지를 예전 데이터 블록에서 복사해 채운 뒤 switch
+//   full    : 그 외 -> 새 블록에 최신 페이지를 위치 순서대로 모아 씀
+// - NAND 프로그램 순서를 지키기 위해 데이터 블록에 바로 쓰는 것은 마지막으로 쓴 위치보다 뒤쪽 빈 페이지일 때만
+// - 페이지 매핑 FTL과 같은 인터페이스 (write / read / getWAF / idle ...)라서 같은 드라이버와 타이밍 모델에 붙음
+//   (설정은 FtlParams의 hybrid / gc를 씀, Ftl.h가 이 헤더를 포함하므로 생성자는 Params 템플릿)
+
+enum class HybridMode {
+    BAST,
+    FAST
+};
+
+struct HybridOptions {
+    HybridMode mode;
+    int log_blocks; // 로그 블록 수 (FAST는 그중 하나가 SW 로그)
+
+    HybridOptions() : mode(HybridMode::BAST), log_blocks(8) {}
+};
+
+inline const char* hybrid_mode_name(HybridMode mode) { return mode == HybridMode::BAST ? "bast" : "fast"; }
+
+// 명령행 인자에서 혼합 FTL 설정을 읽음 (모르는 인자는 건너뜀)
+//   --hybrid bast|fast  --log-blocks N
+inline bool parse_hybrid_args(int argc, char** argv, HybridOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--hybrid") == 0) {
+            std::string mode = value;
+            if (mode == "bast") opt.mode = HybridMode::BAST;
+            else if (mode == "fast") opt.mode = HybridMode::FAST;
+            else {
+                std::cerr << "Hybrid Error: unknown mode '" << mode << "' (bast | fast)." << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (std::strcmp(key, "--log-blocks") == 0) {
+            opt.log_blocks = std::atoi(value); ++i;
+        }
+    }
+    if (opt.log_blocks < (opt.mode == HybridMode::FAST ? 2 : 1)) {
+        std::cerr << "Hybrid Error: --log-blocks must be at least 1 (2 for fast)." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+class HybridFtl {
+public:
+    // 데이터 블록(논리 블록 수) + 로그 블록 + 병합용 여분 한 블록이 물리 블록 안에 들어가야 함
+    // (정적 웨어 레벨링은 페이지 매핑 FTL에만 있음, 빈 블록 할당 순서는 그대로 따름)
+    template <typename Params>
+    static bool validate(const Geometry& geo, const Params& params) {
+        if (params.wear.static_enabled()) {
+            std::cerr << "Hybrid Error: --wl-threshold is only supported by the page-mapped FTL." << std::endl;
+            return false;
+        }
+        long long needed = logical_blocks_for(geo) + params.hybrid.log_blocks + 1;
+        if (needed > geo.num_blocks) {
+            std::cerr << "Hybrid Error: " << logical_blocks_for(geo) << " data blocks + " << params.hybrid.log_blocks
+                      << " log blocks + 1 merge block exceed " << geo.num_blocks << " physical blocks." << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    template <typename Params>
+    static int num_streams_for(const Params&) { return 1; }
+
+    template <typename Params>
+    HybridFtl(const Geometry& geo, const Params& params)
+        : nand_(geo, params.wear.alloc), opt_(params.hybrid), sched_(params.gc),
+          pages_per_block_(geo.pages_per_block),
+          num_logical_pages_(geo.logical_pages()),
+          data_block_(logical_blocks_for(geo), -1), data_fill_(logical_blocks_for(geo), 0),
+          log_of_lbn_(opt_.mode == HybridMode::BAST ? logical_blocks_for(geo) : 0, -1),
+          sw_block_(-1), sw_lbn_(-1),
+          nand_writes_base_(0), user_writes_(0), user_reads_(0), user_trims_(0),
+          switch_merges_(0), partial_merges_(0), full_merges_(0), merge_copies_(0) {
+        for (int i = 0; i < nand_.num_blocks(); ++i) {
+            nand_.erase(i);
+        }
+        log_map_.reserve(static_cast<size_t>(opt_.log_blocks) * pages_per_block_);
+    }
+
+    bool write(Lpn lpn, int = -1) {
+        user_writes_++;
+        int64_t lbn = lpn / pages_per_block_;
+        int off = static_cast<int>(lpn % pages_per_block_);
+
+        invalidate_current(lpn);
+
+        // 데이터 블록의 아직 쓰지 않은 뒤쪽 위치면 그대로 씀 (처음 채우는 쓰기)
+        if (off >= data_fill_[lbn]) {
+            if (data_block_[lbn] == -1 && !allocate(data_block_[lbn])) return false;
+            if (!nand_.write(data_block_[lbn], off, lpn)) return false;
+            data_fill_[lbn] = off + 1;
+            return true;
+        }
+        return opt_.mode == HybridMode::BAST ? write_bast(lpn, lbn) : write_fast(lpn, lbn, off);
+    }
+
+    // 장치 길들이기의 순차 채우기 (Precondition.h). 처음 채우는 쓰기는 write()가 이미 데이터 블록에 바로 씀
+    bool fill_sequential() {
+        for (Lpn lpn = 0; lpn < num_logical_pages_; ++lpn) {
+            if (!write(lpn)) return false;
+        }
+        return true;
+    }
+
+    // TRIM(discard): 구간의 최신 복사본을 무효로 (병합이 더 이상 옮기지 않음)
+    // 유효 페이지가 하나도 남지 않은 논리 블록은 데이터 블록을 바로 지워 빈 블록으로 돌려줌
+    // (범위 검사는 페이지 매핑 Ftl::trim과 같음)
+    bool trim(Lpn lpn, int count) {
+        if (lpn < 0 || lpn >= num_logical_pages_ || count <= 0) return true;
+        Lpn end = lpn + count < num_logical_pages_ ? lpn + count : num_logical_pages_;
+        user_trims_ += end - lpn;
+        for (Lpn l = lpn; l < end; ++l) {
+            invalidate_current(l);
+        }
+        for (int64_t lbn = lpn / pages_per_block_; lbn * pages_per_block_ < end; ++lbn) {
+            release_if_dead(lbn);
+        }
+        return true;
+    }
+
+    void read(Lpn lpn) {
+        user_reads_++;
+        PPA ppa;
+        if (locate(lpn, ppa)) nand_.read(ppa.block, ppa.page);
+    }
+
+    double getWAF() const {
+        if (user_writes_ == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(nand_writes()) / user_writes_;
+    }
+
+    int64_t num_logical_pages() const { return num_logical_pages_; }
+    long long nand_writes() const { return nand_.get_nand_writes() - nand_writes_base_; }
+
+    // 통계를 0부터 다시 셈 (장치 길들이기가 끝난 뒤, 장치 상태는 그대로)
+    void reset_stats() {
+        nand_writes_base_ = nand_.get_nand_writes();
+        user_writes_ = user_reads_ = user_trims_ = 0;
+        switch_merges_ = partial_merges_ = full_merges_ = merge_copies_ = 0;
+    }
+    long long trimmed_pages() const { return user_trims_; }
+
+    // 병합은 쓰기 경로에서만 일어남 (쉬는 구간에 미리 할 일이 없음)
+    int idle() { return 0; }
+    const GcSchedule& gc_schedule() const { return sched_; }
+
+    void set_nand_op_log(std::vector<NandOp>* log) { nand_.set_op_log(log); }
+    const Geometry& geometry() const { return nand_.geometry(); }
+
+    // GC 통계 자리: 병합 횟수 (후보 탐색 비용은 없음)
+    long long gc_count() const { return switch_merges_ + partial_merges_ + full_merges_; }
+    long long victims_examined() const { return 0; }
+
+    // 병합 통계
+    long long switch_merges() const { return switch_merges_; }
+    long long partial_merges() const { return partial_merges_; }
+    long long full_merges() const { return full_merges_; }
+    long long merge_copies() const { return merge_copies_; }
+    long long erases() const { return nand_.get_nand_erases(); }
+    const NandFlash& nand() const { return nand_; }
+
+    // 컨트롤러 DRAM에 두는 매핑: 블록 매핑(논리 블록당 4바이트) + 로그 블록 페이지 매핑(로그 페이지당 4바이트)
+    // + 로그 블록별 소속 LBN
+    template <typename Params>
+    static long long mapping_dram_bytes_for(const Geometry& geo, const Params& params) {
+        return logical_blocks_for(geo) * static_cast<long long>(sizeof(uint32_t)) +
+               static_cast<long long>(params.hybrid.log_blocks) * (geo.pages_per_block + 1) * static_cast<long long>(sizeof(uint32_t));
+    }
+
+    // 시뮬레이터가 실제로 쓰는 메모리 (NAND arena + 블록 매핑 + 로그 페이지 해시)
+    template <typename Params>
+    static long long metadata_bytes_for(const Geometry& geo, const Params& params) {
+        return NandFlash::bytes_for(geo, params.wear.alloc) +
+               logical_blocks_for(geo) * 2 * static_cast<long long>(sizeof(int)) +
+               static_cast<long long>(params.hybrid.log_blocks) * geo.pages_per_block * static_cast<long long>(sizeof(Lpn) + sizeof(PPA));
+    }
+
+    static int64_t logical_blocks_for(const Geometry& geo) {
+        return (geo.logical_pages() + geo.pages_per_block - 1) / geo.pages_per_block;
+    }
+
+private:
+    bool allocate(int& block) {
+        block = nand_.allocate_free_block();
+        if (block == -1) {
+            std::cerr << "Hybrid Fatal Error: no free block." << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // LPN의 최신 복사본 위치 (로그에 있으면 로그, 아니면 데이터 블록)
+    bool locate(Lpn lpn, PPA& ppa) const {
+        std::unordered_map<Lpn, PPA>::const_iterator it = log_map_.find(lpn);
+        if (it != log_map_.end()) {
+            ppa = it->second;
+            return true;
+        }
+        int block = data_block_[lpn / pages_per_block_];
+        int off = static_cast<int>(lpn % pages_per_block_);
+        if (block == -1 || nand_.page_state(block, off) != PageState::VALID) return false;
+        ppa = {block, off};
+        return true;
+    }
+
+    void invalidate_current(Lpn lpn) {
+        PPA ppa;
+        if (!locate(lpn, ppa)) return;
+        nand_.invalidate(ppa.block, ppa.page);
+        log_map_.erase(lpn);
+    }
+
+    // 논리 블록의 데이터 블록에도, 딸린 로그에도 유효 페이지가 없으면 데이터 블록을 지움
+    // (FAST의 RW 로그에 남은 페이지는 해시로 확인, SW 로그가 딸려 있으면 그대로 둠)
+    void release_if_dead(int64_t lbn) {
+        int block = data_block_[lbn];
+        if (block == -1 || nand_.valid_pages(block) > 0) return;
+        if (opt_.mode == HybridMode::BAST ? log_of_lbn_[lbn] != -1 : sw_lbn_ == lbn) return;
+        for (int off = 0; off < pages_per_block_; ++off) {
+            if (log_map_.count(lbn * pages_per_block_ + off)) return;
+        }
+        nand_.erase(block);
+        data_block_[lbn] = -1;
+        data_fill_[lbn] = 0;
+    }
+
+    bool append_log(int block, Lpn lpn) {
+        PPA ppa = {block, nand_.current_page(block)};
+        if (!nand_.write(ppa.block, ppa.page, lpn)) return false;
+        log_map_[lpn] = ppa;
+        return true;
+    }
+
+    // --- BAST: 논리 블록마다 전용 로그 블록 (가득 차거나 로그 블록이 모자라면 가장 먼저 받은 로그부터 병합) ---
+    bool write_bast(Lpn lpn, int64_t lbn) {
+        int& log = log_of_lbn_[lbn];
+        if (log != -1 && nand_.current_page(log) == pages_per_block_) {
+            if (!merge_log(log, lbn)) return false;
+        }
+        if (log == -1) {
+            if (static_cast<int>(log_fifo_.size()) == opt_.log_blocks) {
+                int64_t old_lbn = log_fifo_.front();
+                if (!merge_log(log_of_lbn_[old_lbn], old_lbn)) return false;
+            }
+            if (!allocate(log)) return false;
+            log_fifo_.push_back(lbn);
+        }
+        return append_log(log, lpn);
+    }
+
+    // --- FAST: 위치 0부터 시작하는 쓰기는 SW 로그로, 나머지는 RW 로그에 차례로 ---
+    bool write_fast(Lpn lpn, int64_t lbn, int off) {
+        if (off == 0) {
+            if (sw_block_ != -1 && !merge_log(sw_block_, sw_lbn_)) return false;
+            if (!allocate(sw_block_)) return false;
+            sw_lbn_ = lbn;
+            return append_log(sw_block_, lpn);
+        }
+        if (sw_lbn_ == lbn && nand_.current_page(sw_block_) == off) {
+            if (!append_log(sw_block_, lpn)) return false;
+            if (off == pages_per_block_ - 1) return merge_log(sw_block_, sw_lbn_); // 다 찬 SW 로그는 바로 switch
+            return true;
+        }
+        if (rw_logs_.empty() || nand_.current_page(rw_logs_.back()) == pages_per_block_) {
+            if (static_cast<int>(rw_logs_.size()) == opt_.log_blocks - 1 && !merge_oldest_rw()) return false;
+            int block;
+            if (!allocate(block)) return false;
+            rw_logs_.push_back(block);
+        }
+        return append_log(rw_logs_.back(), lpn);
+    }
+
+    // 가장 오래된 RW 로그에 유효 페이지가 남은 논리 블록마다 full merge 후 그 로그 블록을 지움
+    bool merge_oldest_rw() {
+        int victim = rw_logs_.front();
+        rw_logs_.pop_front();
+        for (int i = nand_.next_valid(victim, 0); i < pages_per_block_; i = nand_.next_valid(victim, i + 1)) {
+            if (!full_merge(nand_.page_lpn(victim, i) / pages_per_block_)) return false;
+        }
+        nand_.erase(victim);
+        return true;
+    }
+
+    // 논리 블록 하나에 딸린 로그 블록(BAST 로그 또는 FAST SW 로그)을 병합: switch > partial > full 순서로 시도
+    bool merge_log(int log, int64_t lbn) {
+        int written = nand_.current_page(log);
+        bool in_order = true;
+        for (int i = 0; i < written && in_order; ++i) {
+            in_order = nand_.page_state(log, i) == PageState::VALID && nand_.page_lpn(log, i) % pages_per_block_ == i;
+        }
+        if (!in_order) return full_merge(lbn);
+
+        int old = data_block_[lbn];
+        int last = written;
+        if (written < pages_per_block_) {
+            // partial: 나머지 위치를 예전 데이터 블록에서 순서대로 채움
+            for (int off = old == -1 ? pages_per_block_ : nand_.next_valid(old, written); off < pages_per_block_;
+                 off = nand_.next_valid(old, off + 1)) {
+                nand_.read(old, off);
+                nand_.invalidate(old, off);
+                if (!nand_.write(log, off, nand_.page_lpn(old, off))) return false;
+                merge_copies_++;
+                last = off + 1;
+            }
+            partial_merges_++;
+        } else {
+            switch_merges_++;
+        }
+        for (int i = 0; i < written; ++i) log_map_.erase(nand_.page_lpn(log, i));
+        if (old != -1) nand_.erase(old);
+        data_block_[lbn] = log;
+        data_fill_[lbn] = last;
+        detach_log(log, lbn);
+        return true;
+    }
+
+    // full merge: 논리 블록의 최신 페이지를 새 블록에 위치 순서대로 모으고, 비게 된 데이터/로그 블록을 지움
+    bool full_merge(int64_t lbn) {
+        int fresh;
+        if (!allocate(fresh)) return false;
+        int old = data_block_[lbn];
+        int fill = 0;
+        for (int off = 0; off < pages_per_block_; ++off) {
+            Lpn lpn = lbn * pages_per_block_ + off;
+            if (lpn >= num_logical_pages_) break;
+            PPA ppa;
+            if (!locate(lpn, ppa)) continue;
+            nand_.read(ppa.block, ppa.page);
+            nand_.invalidate(ppa.block, ppa.page);
+            log_map_.erase(lpn);
+            if (!nand_.write(fresh, off, lpn)) return false;
+            merge_copies_++;
+            fill = off + 1;
+        }
+        if (old != -1) nand_.erase(old);
+        data_block_[lbn] = fresh;
+        data_fill_[lbn] = fill;
+        full_merges_++;
+
+        // 이 논리 블록 전용 로그는 이제 유효 페이지가 없으므로 지움 (RW 로그는 차례가 오면 지움)
+        int log = opt_.mode == HybridMode::BAST ? log_of_lbn_[lbn] : (sw_lbn_ == lbn ? sw_block_ : -1);
+        if (log != -1) {
+            nand_.erase(log);
+            detach_log(log, lbn);
+        }
+        return true;
+    }
+
+    // 병합된 로그 블록을 로그 목록에서 뺌 (블록 자체는 데이터 블록이 되었거나 이미 지워짐)
+    void detach_log(int log, int64_t lbn) {
+        if (opt_.mode == HybridMode::BAST) {
+            log_of_lbn_[lbn] = -1;
+            for (std::deque<int64_t>::iterator it = log_fifo_.begin(); it != log_fifo_.end(); ++it) {
+                if (*it == lbn) {
+                    log_fifo_.erase(it);
+                    break;
+                }
+            }
+        } else if (log == sw_block_) {
+            sw_block_ = -1;
+            sw_lbn_ = -1;
+        }
+    }
+
+    NandFlash nand_;
+    HybridOptions opt_;
+    GcSchedule sched_;
+    int pages_per_block_;
+    int64_t num_logical_pages_;
+
+    std::vector<int> data_block_;  // LBN -> 데이터 블록 (-1이면 아직 없음)
+    std::vector<int> data_fill_;   // LBN -> 데이터 블록에 바로 쓸 수 있는 첫 위치 (NAND 프로그램 순서)
+    std::unordered_map<Lpn, PPA> log_map_; // 로그 블록에 있는 최신 페이지 (로그 블록 페이지 매핑)
+
+    std::vector<int> log_of_lbn_;    // BAST: LBN -> 로그 블록 (-1이면 없음)
+    std::deque<int64_t> log_fifo_;   // BAST: 로그 블록을 받은 LBN 순서 (병합 순서)
+    std::deque<int> rw_logs_;        // FAST: RW 로그 블록 (앞이 가장 오래됨)
+    int sw_block_;                   // FAST: SW 로그 블록과 그 LBN (-1이면 없음)
+    int64_t sw_lbn_;
+
+    long long nand_writes_base_; // reset_stats 시점의 NAND 쓰기 횟수
+    long long user_writes_;
+    long long user_reads_;
+    long long user_trims_;
+    long long switch_merges_, partial_merges_, full_merges_;
+    long long merge_copies_;
+};
+
+#endif // HYBRID_FTL_H
@@ -0,0 +1,54 @@
+#ifndef MAPPING_TABLE_H
+#define MAPPING_TABLE_H
+
+#include <vector>
+#include <cstdint>
+#include "Geometry.h"
+#include "Snapshot.h"
+
+// 물리 페이지 주소 (블록 번호 + 블록 내 페이지 번호)
+// (블록 번호는 32비트로 충분: Geometry::validate()가 블록 수를 INT32_MAX 이하로 제한)
+struct PPA {
+    int block;
+    int page;
+};
+
+// 조밀한(flat) 배열 기반의 L2P 매핑 테이블
+// - LPN은 [0, num_logical_pages) 구간에 빽빽하게 분포하므로 std::map 대신 배열 인덱싱으로 O(1) 조회
+// - 물리 페이지 번호(PPN)는 block * pages_per_block + page 로 압축해서 uint32_t 하나(4바이트)에 저장
+// - 매핑이 없는 칸은 UNMAPPED(0xFFFFFFFF) 값으로 표시
+// - 역방향(PPN -> LPN)은 NandFlash의 페이지 메타에 LPN이 이미 들어있으므로 따로 두지 않음
+class MappingTable {
+public:
+    static constexpr uint32_t UNMAPPED = 0xFFFFFFFFu;
+
+    MappingTable(int64_t num_logical_pages, int pages_per_block)
+        : pages_per_block_(pages_per_block), l2p_(num_logical_pages, UNMAPPED) {}
+
+    bool is_mapped(Lpn lpn) const { return l2p_[lpn] != UNMAPPED; }
+
+    // 호출 전에 is_mapped()로 매핑 여부를 확인해야 함
+    PPA lookup(Lpn lpn) const {
+        Ppn ppn = l2p_[lpn];
+        return {static_cast<int>(ppn / pages_per_block_), static_cast<int>(ppn % pages_per_block_)};
+    }
+
+    void map(Lpn lpn, PPA ppa) { l2p_[lpn] = static_cast<uint32_t>(static_cast<Ppn>(ppa.block) * pages_per_block_ + ppa.page); }
+    void unmap(Lpn lpn) { l2p_[lpn] = UNMAPPED; }
+
+    int64_t num_logical_pages() const { return static_cast<int64_t>(l2p_.size()); }
+
+    static long long bytes_for(int64_t num_logical_pages) {
+        return num_logical_pages * static_cast<long long>(sizeof(uint32_t));
+    }
+    long long metadata_bytes() const { return bytes_for(num_logical_pages()); }
+
+    void save(SnapshotWriter& w) const { w.put(l2p_); }
+    bool load(SnapshotCursor& c) { return c.get_exact(l2p_); }
+
+private:
+    int pages_per_block_;
+    std::vector<uint32_t> l2p_; // LPN -> PPN
+};
+
+#endif // MAPPING_TABLE_H
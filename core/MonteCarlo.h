@@ -0,0 +1,105 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Rng.h"
+
+// 몬테카를로 실행 설정
+struct MonteCarloOptions {
+    uint64_t seed; // 마스터 시드: 실행 i는 Rng(seed, i) 스트림을 사용
+    int threads;   // 작업 스레드 수 (0이면 코어 수만큼)
+    long long ops; // 실행 하나의 요청 수 (정상 상태 조기 종료를 켜면 상한)
+    int runs;      // 실행 수 (신뢰 구간 조기 종료를 켜면 상한)
+    double ci_half_width; // 평균 WAF의 95% 신뢰 구간 반폭이 이 값 이하가 되면 새 실행을 멈춤 (0이면 runs번 모두)
+    int min_runs;  // 신뢰 구간으로 멈추기 전에 최소로 채울 실행 수
+
+    MonteCarloOptions() : seed(1), threads(0), ops(50000), runs(300), ci_half_width(0.0), min_runs(30) {}
+};
+
+// 명령행 인자에서 실행 설정을 읽음 (모르는 인자는 건너뜀)
+//   --seed N  --threads N  --ops N  --runs N  --ci-half-width X  --ci-min-runs N
+inline bool parse_monte_carlo_args(int argc, char** argv, MonteCarloOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0) {
+            opt.seed = std::strtoull(argv[i + 1], nullptr, 10); ++i;
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            opt.threads = std::atoi(argv[i + 1]); ++i;
+        } else if (std::strcmp(argv[i], "--ops") == 0) {
+            opt.ops = std::strtoll(argv[i + 1], nullptr, 10); ++i;
+        } else if (std::strcmp(argv[i], "--runs") == 0) {
+            opt.runs = std::atoi(argv[i + 1]); ++i;
+        } else if (std::strcmp(argv[i], "--ci-half-width") == 0) {
+            opt.ci_half_width = std::atof(argv[i + 1]); ++i;
+        } else if (std::strcmp(argv[i], "--ci-min-runs") == 0) {
+            opt.min_runs = std::atoi(argv[i + 1]); ++i;
+        }
+    }
+    if (opt.ops < 1 || opt.runs < 1 || opt.ci_half_width < 0 || opt.min_runs < 2) {
+        std::cerr << "Monte Carlo Error: --ops and --runs must be at least 1, --ci-min-runs at least 2"
+                  << " and --ci-half-width must not be negative." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+inline int resolve_thread_count(int requested, int num_runs) {
+    int threads = requested > 0 ? requested : static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+    if (threads > num_runs) threads = num_runs;
+    return threads;
+}
+
+// 서로 독립적인 시뮬레이션을 최대 max_runs번, 여러 코어에 나눠서 실행
+// - 각 스레드는 공유 카운터에서 다음 실행 번호를 하나씩 가져감 (먼저 끝난 스레드가 남은 일을 계속 가져가므로 부하가 자동으로 고르게 분산)
+// - run(i, rng)는 실행 i 전용 난수 스트림을 받고 결과 하나를 돌려줌
+// - on_result(i, result)는 뮤텍스 안에서 실행 번호 순서대로 불림 (먼저 끝난 뒤쪽 실행은 앞 번호가 올 때까지 잠시 보관)
+//   false를 돌려주면 새 실행을 더 시작하지 않고, 이미 돌고 있던 뒤쪽 실행의 결과는 버림
+//   -> 어느 실행에서 멈추는지와 넘겨받는 결과는 스레드 수나 완료 순서와 관계없이 항상 같음
+// - 반환값은 on_result에 넘긴 실행 수
+template <typename Result, typename RunFn, typename ResultFn>
+int run_monte_carlo(int max_runs, const MonteCarloOptions& opt, RunFn run, ResultFn on_result) {
+    std::atomic<int> next_run(0);
+    std::atomic<bool> stop(false);
+    std::map<int, Result> pending; // 끝났지만 앞 번호를 기다리는 결과
+    int folded = 0;
+    std::mutex done_mutex;
+
+    auto worker = [&]() {
+        while (!stop.load()) {
+            const int i = next_run.fetch_add(1);
+            if (i >= max_runs) break;
+            Rng rng(opt.seed, static_cast<uint64_t>(i));
+            Result result = run(i, rng);
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if (stop.load()) break;
+            pending.insert(std::make_pair(i, std::move(result)));
+            for (auto it = pending.begin(); it != pending.end() && it->first == folded; it = pending.begin()) {
+                const bool more = on_result(folded, it->second);
+                pending.erase(it);
+                folded++;
+                if (!more) {
+                    stop.store(true);
+                    break;
+                }
+            }
+        }
+    };
+
+    int threads = resolve_thread_count(opt.threads, max_runs);
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker(); // 호출한 스레드도 작업에 참여
+    for (std::thread& th : pool) th.join();
+    return folded;
+}
+
+#endif // MONTE_CARLO_H
@@ -0,0 +1,187 @@
+#include "NandFlash.h"
+#include <cstring>
+#include <algorithm>
+
+NandFlash::NandFlash(const Geometry& geo, AllocPolicy alloc)
+    : geo_(geo),
+      num_blocks_(static_cast<int>(geo.num_blocks)),
+      pages_per_block_(geo.pages_per_block),
+      valid_offset_(static_cast<size_t>(geo.physical_pages())),
+      invalid_offset_(valid_offset_ + num_blocks_),
+      current_offset_(invalid_offset_ + num_blocks_),
+      erase_offset_(current_offset_ + num_blocks_),
+      arena_(erase_offset_ + num_blocks_),
+      block_time_(2 * static_cast<size_t>(num_blocks_)),
+      bitmap_words_((pages_per_block_ + 63) / 64),
+      valid_bits_(static_cast<size_t>(num_blocks_) * bitmap_words_),
+      nand_writes_(0), nand_erases_(0), free_pool_(num_blocks_, alloc), op_log_(nullptr) {
+    reset();
+}
+
+// 모든 페이지를 FREE로, 모든 카운터를 0으로 (arena 전체에 memset 한 번)
+void NandFlash::reset() {
+    std::memset(arena_.data(), 0, arena_.size() * sizeof(uint32_t));
+    std::fill(block_time_.begin(), block_time_.end(), 0);
+    std::fill(valid_bits_.begin(), valid_bits_.end(), 0);
+    nand_writes_ = 0;
+    nand_erases_ = 0;
+    // 처음에는 모든 블록이 비어있으므로 전부 풀에 넣어둠
+    free_pool_.clear();
+    for (int i = 0; i < num_blocks_; ++i) {
+        free_pool_.push(i);
+    }
+}
+
+// 특정 블록의 특정 페이지에 데이터를 쓰는 함수
+bool NandFlash::write(int block_idx, int page_idx, Lpn lpn) {
+    if (block_idx >= num_blocks_ || page_idx >= pages_per_block_) {
+        std::cerr << "Error: Attempted to write to an invalid address." << std::endl;
+        return false;
+    }
+    uint32_t& meta = arena_[page_index(block_idx, page_idx)];
+    if ((meta >> STATE_SHIFT) != static_cast<uint32_t>(PageState::FREE)) {
+        std::cerr << "Error: Attempted to write to a non-free page." << std::endl;
+        return false;
+    }
+
+    meta = pack(PageState::VALID, lpn);
+    valid_word(block_idx, page_idx) |= 1ull << (page_idx & 63);
+    arena_[valid_offset_ + block_idx]++;
+    arena_[current_offset_ + block_idx]++;
+    nand_writes_++; // 물리적 쓰기 횟수 증가
+    block_time_[block_idx] = nand_writes_;
+    if (op_log_) op_log_->push_back(NandOp{NandOpType::PROGRAM, block_idx});
+    return true;
+}
+
+// 같은 블록에 이어지는 페이지를 한 번에 씀 (페이지 메타만 채우고 카운터/시각은 끝에서 한 번 갱신)
+bool NandFlash::write_run(int block_idx, Lpn first, int count) {
+    if (block_idx >= num_blocks_ || count < 0) {
+        std::cerr << "Error: Attempted to write to an invalid address." << std::endl;
+        return false;
+    }
+    const int start = current_page(block_idx);
+    if (start + count > pages_per_block_) {
+        std::cerr << "Error: Attempted to write past the end of a block." << std::endl;
+        return false;
+    }
+    uint32_t* meta = &arena_[page_index(block_idx, start)];
+    for (int i = 0; i < count; ++i) {
+        meta[i] = pack(PageState::VALID, first + i);
+    }
+    set_valid_range(block_idx, start, count);
+    arena_[valid_offset_ + block_idx] += count;
+    arena_[current_offset_ + block_idx] += count;
+    nand_writes_ += count;
+    block_time_[block_idx] = nand_writes_;
+    if (op_log_) op_log_->insert(op_log_->end(), count, NandOp{NandOpType::PROGRAM, block_idx});
+    return true;
+}
+
+// 특정 페이지의 데이터를 읽는 함수 (시뮬레이션에서는 상태 확인만 수행)
+bool NandFlash::read(int block_idx, int page_idx) {
+    if (block_idx >= num_blocks_ || page_idx >= pages_per_block_) {
+        std::cerr << "Error: Attempted to read from an invalid address." << std::endl;
+        return false;
+    }
+    if (op_log_) op_log_->push_back(NandOp{NandOpType::READ, block_idx});
+    return page_state(block_idx, page_idx) == PageState::VALID;
+}
+
+// 유효한 페이지를 무효화하는 함수 (LPN은 그대로 남겨둠)
+bool NandFlash::invalidate(int block_idx, int page_idx) {
+    uint32_t& meta = arena_[page_index(block_idx, page_idx)];
+    if ((meta >> STATE_SHIFT) != static_cast<uint32_t>(PageState::VALID)) {
+        std::cerr << "Error: Attempted to invalidate a non-valid page." << std::endl;
+        return false;
+    }
+    meta = pack(PageState::INVALID, static_cast<Lpn>(meta & LPN_MASK));
+    valid_word(block_idx, page_idx) &= ~(1ull << (page_idx & 63));
+    arena_[valid_offset_ + block_idx]--;
+    arena_[invalid_offset_ + block_idx]++;
+    block_time_[block_idx] = nand_writes_;
+    return true;
+}
+
+// 특정 블록 전체를 지우는 함수
+bool NandFlash::erase(int block_idx) {
+    if (block_idx >= num_blocks_) {
+        std::cerr << "Error: Attempted to erase an invalid block." << std::endl;
+        return false;
+    }
+
+    // 블록의 페이지 메타는 arena 안에서 연속이므로 한 번에 0(FREE)으로 지움
+    std::memset(&arena_[page_index(block_idx, 0)], 0, pages_per_block_ * sizeof(uint32_t));
+    std::memset(&valid_word(block_idx, 0), 0, bitmap_words_ * sizeof(uint64_t));
+
+    arena_[erase_offset_ + block_idx]++;
+    arena_[valid_offset_ + block_idx] = 0;
+    arena_[invalid_offset_ + block_idx] = 0;
+    arena_[current_offset_ + block_idx] = 0;
+    nand_erases_++; // 블록 지우기 횟수 증가
+    if (op_log_) op_log_->push_back(NandOp{NandOpType::ERASE, block_idx});
+    free_pool_.push(block_idx, arena_[erase_offset_ + block_idx]); // 지워진 블록은 다시 빈 블록 풀로
+    return true;
+}
+
+void NandFlash::save(SnapshotWriter& w) const {
+    w.begin(SNAP_NAND);
+    w.put(arena_);
+    w.put(block_time_);
+    w.put_value(nand_writes_);
+    w.put_value(nand_erases_);
+    w.begin(SNAP_FREE_POOL);
+    free_pool_.save(w);
+}
+
+bool NandFlash::load(const SnapshotReader& r) {
+    SnapshotCursor c = r.section(SNAP_NAND);
+    c.get_exact(arena_);
+    c.get_exact(block_time_);
+    long long writes = c.value();
+    long long erases = c.value();
+    SnapshotCursor pool = r.section(SNAP_FREE_POOL);
+    if (!c.ok() || !free_pool_.load(pool, &arena_[erase_offset_])) {
+        std::cerr << "Snapshot Error: NAND state is missing or does not match the device." << std::endl;
+        return false;
+    }
+    nand_writes_ = writes;
+    nand_erases_ = erases;
+    rebuild_valid_bits();
+    return true;
+}
+
+// 페이지 [first, first + count)의 비트를 켬 (워드 단위로 마스크를 만들어 한 번에)
+void NandFlash::set_valid_range(int block_idx, int first, int count) {
+    uint64_t* words = &valid_word(block_idx, 0);
+    for (int p = first; p < first + count;) {
+        const int bit = p & 63;
+        const int n = std::min(64 - bit, first + count - p);
+        const uint64_t mask = n == 64 ? ~0ull : ((1ull << n) - 1) << bit;
+        words[p >> 6] |= mask;
+        p += n;
+    }
+}
+
+// 페이지 메타에서 VALID 비트맵을 다시 만듦 (스냅샷을 불러온 뒤)
+void NandFlash::rebuild_valid_bits() {
+    std::fill(valid_bits_.begin(), valid_bits_.end(), 0);
+    for (int b = 0; b < num_blocks_; ++b) {
+        for (int p = 0; p < pages_per_block_; ++p) {
+            if (page_state(b, p) == PageState::VALID) valid_word(b, p) |= 1ull << (p & 63);
+        }
+    }
+}
+
+// 분기 없는 popcount 합이라 컴파일러가 SIMD로 벡터화할 수 있음
+// (GCC/clang 모두 -mavx512vpopcntdq면 한 명령에 8워드, clang은 -mavx2에서도 니블 표 조회 방식,
+//  그 밖에는 워드마다 popcnt 한 번 = 페이지 64개)
+long long NandFlash::total_valid_pages() const {
+    const uint64_t* words = valid_bits_.data();
+    const size_t n = valid_bits_.size();
+    long long total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        total += __builtin_popcountll(words[i]);
+    }
+    return total;
+}
@@ -0,0 +1,171 @@
+#ifndef NANDFLASH_H
+#define NANDFLASH_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+#include "Geometry.h"
+#include "FreeBlockPool.h"
+#include "Snapshot.h"
+
+// 페이지의 상태를 나타내는 열거형
+enum class PageState {
+    FREE,       // 비어있는 상태
+    VALID,      // 유효한 데이터가 저장된 상태
+    INVALID     // 오래된, 무효화된 데이터가 저장된 상태
+};
+
+// 실제로 수행된 NAND 명령 (타이밍 모델이 소요 시간을 계산할 때 사용)
+enum class NandOpType : uint8_t {
+    READ,
+    PROGRAM,
+    ERASE
+};
+
+struct NandOp {
+    NandOpType type;
+    int block;
+};
+
+// NAND 플래시 메모리 시뮬레이션 클래스
+//
+// 메타데이터는 하나의 연속된 uint32_t 배열(arena)에 구조체 배열(SoA) 형태로 저장:
+//   [페이지 메타 x (num_blocks * pages_per_block)][valid x num_blocks][invalid x num_blocks]
+//   [current_page x num_blocks][erase_count x num_blocks]
+// 페이지 메타 한 칸(4바이트) = 상위 2비트 상태 + 하위 30비트 LPN (P2L 역매핑을 겸함)
+// FREE 상태가 0이므로 장치 전체 초기화는 memset 한 번으로 끝남
+//
+// 블록 시각은 32비트를 넘을 수 있으므로 별도의 64비트 배열에 [last_modified x num_blocks][sealed_at x num_blocks]
+// (시각 = 그때까지의 NAND 페이지 쓰기 횟수, 장치 내부의 논리 시계)
+//
+// 페이지 메타와 별도로 블록마다 VALID 페이지 비트맵을 둠 (64페이지 = uint64_t 한 워드, 블록 사이에 워드를 나누지 않음)
+// GC/병합은 next_valid()로 유효 페이지만 건너뛰며 읽으므로 비용이 블록 크기가 아니라 유효 페이지 수에 비례
+// (비트맵은 페이지 메타에서 다시 만들 수 있으므로 스냅샷에는 넣지 않음)
+class NandFlash {
+public:
+    // alloc: 빈 블록 풀에서 블록을 꺼내는 순서 (FreeBlockPool.h)
+    explicit NandFlash(const Geometry& geo = Geometry(), AllocPolicy alloc = AllocPolicy::FIFO);
+
+    // NAND 기본 동작 함수
+    bool write(int block, int page, Lpn lpn);
+    bool read(int block, int page);
+    bool erase(int block);
+
+    // 블록의 다음 쓰기 위치부터 LPN first, first + 1, ... 을 count개 연달아 씀
+    // (write()를 count번 부른 것과 같은 결과, 장치 길들이기의 순차 채우기용)
+    bool write_run(int block, Lpn first, int count);
+
+    // VALID 페이지를 INVALID로 바꾸고 블록 카운터를 갱신 (덮어쓰기 시 FTL이 호출)
+    bool invalidate(int block, int page);
+
+    // 명령 기록: log가 nullptr이 아니면 성공한 read/write/erase를 순서대로 뒤에 덧붙임
+    // (기록 중이 아닐 때의 비용은 포인터 검사 한 번)
+    void set_op_log(std::vector<NandOp>* log) { op_log_ = log; }
+
+    // 장치를 공장 출하 상태로 되돌림 (모든 페이지 FREE, 모든 카운터 0)
+    void reset();
+
+    const Geometry& geometry() const { return geo_; }
+    int num_blocks() const { return num_blocks_; }
+    int pages_per_block() const { return pages_per_block_; }
+
+    // 페이지 메타데이터 GETTER
+    PageState page_state(int block, int page) const {
+        return static_cast<PageState>(arena_[page_index(block, page)] >> STATE_SHIFT);
+    }
+    // 페이지에 저장된 LPN (FREE 페이지면 -1)
+    Lpn page_lpn(int block, int page) const {
+        uint32_t meta = arena_[page_index(block, page)];
+        return (meta >> STATE_SHIFT) == 0 ? -1 : static_cast<Lpn>(meta & LPN_MASK);
+    }
+
+    // 블록 카운터 GETTER
+    int valid_pages(int block) const { return static_cast<int>(arena_[valid_offset_ + block]); }
+    int invalid_pages(int block) const { return static_cast<int>(arena_[invalid_offset_ + block]); }
+    int current_page(int block) const { return static_cast<int>(arena_[current_offset_ + block]); }
+    int erase_count(int block) const { return static_cast<int>(arena_[erase_offset_ + block]); }
+
+    // 블록에서 page 이상인 첫 VALID 페이지 번호 (없으면 pages_per_block)
+    // 워드 안에서는 0이 아닌 가장 낮은 비트를 tzcnt로 바로 찾음
+    //   for (int p = nand.next_valid(b, 0); p < ppb; p = nand.next_valid(b, p + 1)) ...
+    // 순회 중에 지금 페이지를 무효화해도 됨 (다음 호출이 비트맵을 다시 읽음)
+    int next_valid(int block, int page) const {
+        if (page >= pages_per_block_) return pages_per_block_;
+        const uint64_t* words = &valid_bits_[static_cast<size_t>(block) * bitmap_words_];
+        int k = page >> 6;
+        uint64_t bits = words[k] & (~0ull << (page & 63));
+        while (bits == 0) {
+            if (++k == bitmap_words_) return pages_per_block_;
+            bits = words[k];
+        }
+        return (k << 6) + __builtin_ctzll(bits);
+    }
+
+    // 장치 전체의 VALID 페이지 수 (비트맵 배열 전체의 popcount 합)
+    long long total_valid_pages() const;
+
+    // 블록 시각 GETTER (나이 기반 GC 희생양 선택용)
+    // - last_modified: 블록에 마지막으로 페이지가 쓰이거나 무효화된 시각
+    // - sealed_at: FTL이 블록을 다 쓰고 닫은(mark_sealed) 시각
+    long long now() const { return nand_writes_; }
+    long long last_modified(int block) const { return block_time_[block]; }
+    long long sealed_at(int block) const { return block_time_[num_blocks_ + block]; }
+    void mark_sealed(int block) { block_time_[num_blocks_ + block] = nand_writes_; }
+
+    // 통계 정보 GETTER
+    long long get_nand_writes() const { return nand_writes_; }
+    long long get_nand_erases() const { return nand_erases_; }
+
+    // 빈 블록 풀: erase()된 블록이 들어오고, 여기서 꺼낸 블록은 더 이상 Free로 세지 않음
+    int allocate_free_block() { return free_pool_.pop(); }
+    int free_block_count() const { return free_pool_.size(); }
+    bool in_free_pool(int block) const { return free_pool_.contains(block); }
+
+    // 장치 메타데이터가 차지하는 메모리 (arena + 블록 시각 + VALID 비트맵 + 빈 블록 풀)
+    static long long bytes_for(const Geometry& geo, AllocPolicy alloc = AllocPolicy::FIFO) {
+        return (geo.physical_pages() + 4 * geo.num_blocks) * static_cast<long long>(sizeof(uint32_t)) +
+               2 * geo.num_blocks * static_cast<long long>(sizeof(long long)) +
+               geo.num_blocks * ((geo.pages_per_block + 63) / 64) * static_cast<long long>(sizeof(uint64_t)) +
+               FreeBlockPool::bytes_for(static_cast<int>(geo.num_blocks), alloc);
+    }
+    long long metadata_bytes() const { return bytes_for(geo_, free_pool_.policy()); }
+
+    // 스냅샷 (Snapshot.h): arena, 블록 시각, 쓰기/지우기 횟수(SNAP_NAND)와 빈 블록 풀(SNAP_FREE_POOL)
+    // (명령 기록 대상은 저장하지 않음, 불러올 때는 규격이 같아야 함)
+    void save(SnapshotWriter& w) const;
+    bool load(const SnapshotReader& r);
+
+private:
+    static const int STATE_SHIFT = 30;
+    static const uint32_t LPN_MASK = (1u << STATE_SHIFT) - 1;
+
+    size_t page_index(int block, int page) const {
+        return static_cast<size_t>(block) * pages_per_block_ + page;
+    }
+    static uint32_t pack(PageState state, Lpn lpn) {
+        return (static_cast<uint32_t>(state) << STATE_SHIFT) | (static_cast<uint32_t>(lpn) & LPN_MASK);
+    }
+    uint64_t& valid_word(int block, int page) {
+        return valid_bits_[static_cast<size_t>(block) * bitmap_words_ + (page >> 6)];
+    }
+    void set_valid_range(int block, int first, int count);
+    void rebuild_valid_bits();
+
+    Geometry geo_;
+    int num_blocks_;
+    int pages_per_block_;
+    // arena 안에서 블록 카운터 배열들이 시작하는 위치
+    size_t valid_offset_, invalid_offset_, current_offset_, erase_offset_;
+
+    std::vector<uint32_t> arena_; // 페이지 메타 + 블록 카운터 (단일 할당)
+    std::vector<long long> block_time_; // 블록별 last_modified + sealed_at
+    int bitmap_words_;                  // 블록 하나의 비트맵 워드 수 (= ceil(pages_per_block / 64))
+    std::vector<uint64_t> valid_bits_;  // 블록별 VALID 페이지 비트맵 (bitmap_words_개씩)
+    long long nand_writes_; // NAND에 직접 쓰기 작업이 발생한 총 횟수
+    long long nand_erases_; // 블록 지우기 작업이 발생한 총 횟수
+    FreeBlockPool free_pool_; // 지워진 뒤 아직 할당되지 않은 블록들 (FIFO 또는 지우기 횟수 최소 힙)
+    std::vector<NandOp>* op_log_; // 명령 기록 대상 (없으면 nullptr)
+};
+
+#endif // NANDFLASH_H
@@ -0,0 +1,114 @@
+#ifndef PRECONDITION_H
+#define PRECONDITION_H
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "Geometry.h"
+#include "Rng.h"
+
+// 측정 전 장치 길들이기 (preconditioning): 빈 장치에서 시작하면 처음 한동안은 GC가 없어 WAF가 낮게 나오므로
+// 정상 상태(steady state)에 가까운 장치에서 측정을 시작함
+// 1. 순차 채우기: LPN 0 ~ 끝을 한 번씩 씀. FTL의 fill_sequential()이 같은 Active Block에 이어지는
+//    LPN 묶음을 NAND/매핑에 한 번에 기록함 (write()를 LPN 순서대로 부른 것과 상태가 완전히 같음)
+// 2. 무작위 덮어쓰기 (선택): 균일 무작위 LPN을 write()로 덮어쓰며 창(논리 용량의 절반)마다 WAF를 재서
+//    직전 창과 차이가 tolerance 이하가 되면 (희생양의 유효 페이지 분포가 안정되면) 멈춤
+//    GC가 끼므로 write()를 그대로 쓰고, 드라이버/워크로드/버퍼를 거치지 않는 만큼만 빨라짐
+// - 끝나면 드라이버가 통계를 0으로 돌리므로 측정에는 들어가지 않음
+
+enum class PreconditionMode {
+    NONE,
+    FILL,   // 순차 채우기만
+    RANDOM  // 순차 채우기 + 무작위 덮어쓰기
+};
+
+struct PreconditionOptions {
+    PreconditionMode mode;
+    double max_passes;  // 무작위 덮어쓰기 상한 (논리 용량의 몇 배)
+    double tolerance;   // 창 사이 WAF 차이가 이 비율 이하면 안정된 것으로 봄
+
+    PreconditionOptions() : mode(PreconditionMode::NONE), max_passes(8.0), tolerance(0.01) {}
+
+    bool enabled() const { return mode != PreconditionMode::NONE; }
+};
+
+inline const char* precondition_mode_name(PreconditionMode mode) {
+    switch (mode) {
+    case PreconditionMode::NONE: return "none";
+    case PreconditionMode::FILL: return "fill";
+    case PreconditionMode::RANDOM: return "random";
+    }
+    return "?";
+}
+
+// 명령행 인자에서 길들이기 설정을 읽음 (모르는 인자는 건너뜀)
+//   --precondition none|fill|random  --precondition-passes X  --precondition-tol X
+inline bool parse_precondition_args(int argc, char** argv, PreconditionOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--precondition") == 0) {
+            std::string mode = value;
+            if (mode == "none") opt.mode = PreconditionMode::NONE;
+            else if (mode == "fill") opt.mode = PreconditionMode::FILL;
+            else if (mode == "random") opt.mode = PreconditionMode::RANDOM;
+            else {
+                std::cerr << "Precondition Error: unknown mode '" << mode << "' (none | fill | random)." << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (std::strcmp(key, "--precondition-passes") == 0) {
+            opt.max_passes = std::atof(value); ++i;
+        } else if (std::strcmp(key, "--precondition-tol") == 0) {
+            opt.tolerance = std::atof(value); ++i;
+        }
+    }
+    if (opt.max_passes <= 0 || opt.tolerance < 0) {
+        std::cerr << "Precondition Error: --precondition-passes must be positive and --precondition-tol must not be negative." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 길들이기 결과 (드라이버 출력용)
+struct PreconditionResult {
+    long long fill_writes;      // 순차 채우기에서 쓴 페이지 수
+    long long overwrite_writes; // 무작위 덮어쓰기에서 쓴 페이지 수
+    double last_window_waf;     // 마지막 창의 WAF (안정된 값의 추정)
+    bool stable;                // 상한 전에 안정됐는지
+
+    PreconditionResult() : fill_writes(0), overwrite_writes(0), last_window_waf(0.0), stable(false) {}
+};
+
+// 장치를 길들임 (FtlT는 fill_sequential / write / nand_writes / num_logical_pages를 가진 FTL)
+// 실패하면 false (FTL이 이유를 출력함)
+template <typename FtlT>
+bool precondition(FtlT& ftl, const PreconditionOptions& opt, Rng& rng, PreconditionResult& result) {
+    if (!opt.enabled()) return true;
+    const int64_t n = ftl.num_logical_pages();
+    if (!ftl.fill_sequential()) return false;
+    result.fill_writes = n;
+    if (opt.mode != PreconditionMode::RANDOM) return true;
+
+    const long long window = n / 2 > 0 ? n / 2 : 1;
+    const long long limit = static_cast<long long>(opt.max_passes * n);
+    double prev_waf = -1.0;
+    while (result.overwrite_writes < limit) {
+        const long long start = ftl.nand_writes();
+        for (long long i = 0; i < window; ++i) {
+            if (!ftl.write(static_cast<Lpn>(rng.below(static_cast<uint64_t>(n))))) return false;
+        }
+        result.overwrite_writes += window;
+        result.last_window_waf = static_cast<double>(ftl.nand_writes() - start) / window;
+        if (prev_waf > 0 && std::fabs(result.last_window_waf - prev_waf) <= opt.tolerance * result.last_window_waf) {
+            result.stable = true;
+            break;
+        }
+        prev_waf = result.last_window_waf;
+    }
+    return true;
+}
+
+#endif // PRECONDITION_H
@@ -0,0 +1,55 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// SplitMix64: 마스터 시드에서 실행(run)별 시드를 뽑아내는 용도
+// (연속된 입력도 서로 상관없는 64비트 값으로 흩어줌)
+inline uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// 시뮬레이션 한 번이 독점해서 쓰는 빠른 난수 생성기 (xoshiro256**)
+// - 전역 상태가 없으므로 스레드마다/실행마다 따로 두면 서로 간섭하지 않음
+// - (master_seed, stream) 쌍이 같으면 어떤 스레드에서 돌든 항상 같은 수열
+class Rng {
+public:
+    explicit Rng(uint64_t master_seed, uint64_t stream = 0) {
+        uint64_t sm = master_seed ^ (stream * 0xD1B54A32D192ED03ull);
+        for (int i = 0; i < 4; ++i) s_[i] = splitmix64(sm);
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    // [0, n) 구간의 정수 (곱셈-시프트 방식, 나눗셈 없음)
+    uint64_t below(uint64_t n) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(next()) * n) >> 64);
+    }
+
+    // [0, 1) 구간의 실수
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // 내부 상태 4워드 (스냅샷으로 수열을 이어 가는 용도)
+    void get_state(uint64_t out[4]) const { for (int i = 0; i < 4; ++i) out[i] = s_[i]; }
+    void set_state(const uint64_t in[4]) { for (int i = 0; i < 4; ++i) s_[i] = in[i]; }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s_[4];
+};
+
+#endif // RNG_H
@@ -0,0 +1,315 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Geometry.h"
+#include "MappedFile.h"
+
+// FTL 전체 상태의 이진 스냅샷 (웜 스타트: 한 번 채워 둔 장치를 여러 실험이 그대로 불러 씀)
+//
+// 파일 형식 (버전 1, 호스트 바이트 순서 = 리틀 엔디언)
+//   헤더 64바이트: magic "FTLSNAP1" | version u32 | section_count u32 | table_offset u64 |
+//                  num_blocks u64 | pages_per_block u32 | page_size u32 | logical_pages u64 | 0 x 16
+//   섹션 본문들: 섹션 하나 = 필드 여러 개, 필드 하나 = [bytes u64][데이터][0으로 8바이트 정렬]
+//   섹션 표 (파일 끝): section_count x {id u32, 0 u32, offset u64, bytes u64}
+// - 모든 필드 데이터가 8바이트 경계에서 시작하므로 mmap한 파일 위에서 그대로 배열로 볼 수 있음
+//   (읽을 때는 맵된 영역에서 각 구조체의 배열로 memcpy 한 번씩)
+// - 섹션 표를 끝에 두므로 쓰는 쪽은 큰 배열을 복사 없이 바로 파일로 흘려보냄
+// - 모르는 섹션은 무시하고, 없는 섹션은 구성 요소마다 처리 (섹션을 더하는 것은 호환, 필드 배치가 바뀌면 버전을 올림)
+
+const uint32_t SNAPSHOT_VERSION = 1;
+static const char SNAPSHOT_MAGIC[8] = {'F', 'T', 'L', 'S', 'N', 'A', 'P', '1'};
+static const size_t SNAPSHOT_HEADER_SIZE = 64;
+
+// 섹션 번호 (스트림마다 하나씩인 섹션은 기준 번호 + 스트림 번호)
+enum SnapshotSection : uint32_t {
+    SNAP_NAND = 1,          // NandFlash: arena, 블록 시각, 쓰기/지우기 횟수
+    SNAP_FREE_POOL = 2,     // 빈 블록 풀
+    SNAP_L2P = 3,           // 매핑 테이블
+    SNAP_FTL = 4,           // Ftl 스칼라 상태, 스트림별 Active Block, GC 난수
+    SNAP_DFTL = 5,          // CMT, GTD, 갱신 대기 번역 페이지
+    SNAP_CLASSIFIER = 6,    // 분류기 상태 (분류기 이름 + 분류기별 필드)
+    SNAP_VICTIM_INDEX = 0x100 // + 스트림 번호
+};
+
+// FTL이 스냅샷을 불러온 결과
+// - EXACT   : 저장할 때와 같은 상태 (이어서 돌리면 저장하지 않고 계속 돌린 것과 결과가 같음)
+// - REBUILT : 장치 내용(NAND, 매핑)은 그대로지만 정책 조합이 달라 스트림 배치나 분류기 상태를 새로 만듦
+// - FAILED  : 불러올 수 없음 (이유는 출력됨)
+enum class SnapshotLoad {
+    FAILED,
+    EXACT,
+    REBUILT
+};
+
+struct SnapshotOptions {
+    std::string save_path; // 비어 있지 않으면 첫 번째 실행이 끝난 상태를 여기에 저장
+    std::string load_path; // 비어 있지 않으면 모든 실행이 이 상태에서 시작
+
+    bool saving() const { return !save_path.empty(); }
+    bool loading() const { return !load_path.empty(); }
+};
+
+// 명령행 인자에서 스냅샷 설정을 읽음 (모르는 인자는 건너뜀)
+//   --save-snapshot PATH  --load-snapshot PATH
+inline bool parse_snapshot_args(int argc, char** argv, SnapshotOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--save-snapshot") == 0) {
+            opt.save_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--load-snapshot") == 0) {
+            opt.load_path = argv[++i];
+        }
+    }
+    if (opt.saving() && opt.loading() && opt.save_path == opt.load_path) {
+        std::cerr << "Snapshot Error: --save-snapshot and --load-snapshot must name different files." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 스냅샷 쓰기: open -> (begin -> put...)* -> close
+class SnapshotWriter {
+public:
+    SnapshotWriter() : fp_(nullptr), offset_(0), ok_(true) {}
+    ~SnapshotWriter() { if (fp_) std::fclose(fp_); }
+
+    bool open(const char* path, const Geometry& geo) {
+        fp_ = std::fopen(path, "wb");
+        if (!fp_) {
+            std::cerr << "Snapshot Error: cannot create '" << path << "'." << std::endl;
+            return false;
+        }
+        geo_ = geo;
+        char zero[SNAPSHOT_HEADER_SIZE] = {0};
+        raw(zero, sizeof(zero)); // 헤더는 close에서 채움
+        return ok_;
+    }
+
+    // 새 섹션 시작 (앞 섹션은 자동으로 끝남)
+    void begin(uint32_t id) {
+        end_section();
+        Entry e = {id, 0, offset_, 0};
+        table_.push_back(e);
+    }
+
+    template <typename T>
+    void put(const T* data, size_t count) {
+        uint64_t bytes = count * sizeof(T);
+        raw(&bytes, sizeof(bytes));
+        if (bytes) raw(data, bytes);
+        static const char pad[8] = {0};
+        if (bytes % 8) raw(pad, 8 - bytes % 8);
+    }
+    template <typename T>
+    void put(const std::vector<T>& v) { put(v.data(), v.size()); }
+    void put_value(int64_t value) { put(&value, 1); }
+
+    bool close() {
+        end_section();
+        uint64_t table_offset = offset_;
+        for (size_t i = 0; i < table_.size(); ++i) raw(&table_[i], sizeof(Entry));
+        char header[SNAPSHOT_HEADER_SIZE] = {0};
+        uint32_t count = static_cast<uint32_t>(table_.size());
+        uint64_t blocks = static_cast<uint64_t>(geo_.num_blocks);
+        uint32_t ppb = static_cast<uint32_t>(geo_.pages_per_block);
+        uint32_t page_size = static_cast<uint32_t>(geo_.page_size);
+        uint64_t logical = static_cast<uint64_t>(geo_.logical_pages());
+        std::memcpy(header, SNAPSHOT_MAGIC, 8);
+        std::memcpy(header + 8, &SNAPSHOT_VERSION, 4);
+        std::memcpy(header + 12, &count, 4);
+        std::memcpy(header + 16, &table_offset, 8);
+        std::memcpy(header + 24, &blocks, 8);
+        std::memcpy(header + 32, &ppb, 4);
+        std::memcpy(header + 36, &page_size, 4);
+        std::memcpy(header + 40, &logical, 8);
+        if (ok_ && std::fseek(fp_, 0, SEEK_SET) == 0) {
+            ok_ = std::fwrite(header, 1, sizeof(header), fp_) == sizeof(header);
+        } else {
+            ok_ = false;
+        }
+        ok_ = std::fclose(fp_) == 0 && ok_;
+        fp_ = nullptr;
+        if (!ok_) std::cerr << "Snapshot Error: write failed." << std::endl;
+        return ok_;
+    }
+
+private:
+    struct Entry {
+        uint32_t id;
+        uint32_t reserved;
+        uint64_t offset;
+        uint64_t bytes;
+    };
+
+    void raw(const void* data, size_t bytes) {
+        if (ok_ && std::fwrite(data, 1, bytes, fp_) != bytes) ok_ = false;
+        offset_ += bytes;
+    }
+
+    void end_section() {
+        if (!table_.empty() && table_.back().bytes == 0) table_.back().bytes = offset_ - table_.back().offset;
+    }
+
+    FILE* fp_;
+    Geometry geo_;
+    uint64_t offset_;
+    std::vector<Entry> table_;
+    bool ok_;
+};
+
+// 섹션 하나의 필드를 앞에서부터 읽음 (형식이 맞지 않으면 ok()가 false가 되고 이후 읽기는 모두 실패)
+class SnapshotCursor {
+public:
+    SnapshotCursor() : cur_(nullptr), end_(nullptr), ok_(false) {}
+    SnapshotCursor(const char* begin, const char* end) : cur_(begin), end_(end), ok_(begin != nullptr) {}
+
+    bool ok() const { return ok_; }
+
+    // 필드 길이에 맞춰 v의 크기를 바꿈
+    template <typename T>
+    bool get(std::vector<T>& v) {
+        const char* data;
+        uint64_t bytes;
+        if (!field(data, bytes) || bytes % sizeof(T) != 0) return fail();
+        v.resize(bytes / sizeof(T));
+        if (bytes) std::memcpy(v.data(), data, bytes);
+        return true;
+    }
+    // 길이가 정확히 count개여야 함 (구조체가 이미 잡아 둔 배열을 채울 때)
+    template <typename T>
+    bool get_exact(T* out, size_t count) {
+        const char* data;
+        uint64_t bytes;
+        if (!field(data, bytes) || bytes != count * sizeof(T)) return fail();
+        if (bytes) std::memcpy(out, data, bytes);
+        return true;
+    }
+    template <typename T>
+    bool get_exact(std::vector<T>& v) { return get_exact(v.data(), v.size()); }
+
+    int64_t value() {
+        int64_t v = 0;
+        get_exact(&v, 1);
+        return v;
+    }
+
+private:
+    bool field(const char*& data, uint64_t& bytes) {
+        if (!ok_ || end_ - cur_ < 8) return false;
+        std::memcpy(&bytes, cur_, 8);
+        uint64_t padded = (bytes + 7) / 8 * 8;
+        if (static_cast<uint64_t>(end_ - cur_ - 8) < padded) return false;
+        data = cur_ + 8;
+        cur_ += 8 + padded;
+        return true;
+    }
+    bool fail() {
+        ok_ = false;
+        return false;
+    }
+
+    const char* cur_;
+    const char* end_;
+    bool ok_;
+};
+
+// 스냅샷 읽기: 파일을 mmap하고 섹션 표만 해석 (본문은 섹션을 읽을 때 필요한 만큼만 OS가 올림)
+// 읽기 전용이라 여러 스레드가 하나를 같이 써도 됨
+class SnapshotReader {
+public:
+    SnapshotReader() : num_blocks_(0), pages_per_block_(0), page_size_(0), logical_pages_(0) {}
+
+    bool open(const char* path) {
+        if (!file_.open(path)) {
+            std::cerr << "Snapshot Error: cannot open '" << path << "'." << std::endl;
+            return false;
+        }
+        const char* d = file_.data();
+        if (file_.size() < SNAPSHOT_HEADER_SIZE || std::memcmp(d, SNAPSHOT_MAGIC, 8) != 0) {
+            std::cerr << "Snapshot Error: '" << path << "' is not a snapshot file." << std::endl;
+            return false;
+        }
+        uint32_t version, count;
+        uint64_t table_offset;
+        std::memcpy(&version, d + 8, 4);
+        std::memcpy(&count, d + 12, 4);
+        std::memcpy(&table_offset, d + 16, 8);
+        std::memcpy(&num_blocks_, d + 24, 8);
+        std::memcpy(&pages_per_block_, d + 32, 4);
+        std::memcpy(&page_size_, d + 36, 4);
+        std::memcpy(&logical_pages_, d + 40, 8);
+        if (version != SNAPSHOT_VERSION) {
+            std::cerr << "Snapshot Error: version " << version << " is not supported (expected "
+                      << SNAPSHOT_VERSION << ")." << std::endl;
+            return false;
+        }
+        if (table_offset > file_.size() || (file_.size() - table_offset) / ENTRY_SIZE < count) {
+            std::cerr << "Snapshot Error: '" << path << "' is truncated." << std::endl;
+            return false;
+        }
+        table_.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const char* e = d + table_offset + i * ENTRY_SIZE;
+            std::memcpy(&table_[i].id, e, 4);
+            std::memcpy(&table_[i].offset, e + 8, 8);
+            std::memcpy(&table_[i].bytes, e + 16, 8);
+            if (table_[i].offset > table_offset || table_offset - table_[i].offset < table_[i].bytes) {
+                std::cerr << "Snapshot Error: '" << path << "' has a corrupt section table." << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 장치 규격이 같아야 불러올 수 있음
+    bool matches(const Geometry& geo) const {
+        if (num_blocks_ != static_cast<uint64_t>(geo.num_blocks) ||
+            pages_per_block_ != static_cast<uint32_t>(geo.pages_per_block) ||
+            page_size_ != static_cast<uint32_t>(geo.page_size) ||
+            logical_pages_ != static_cast<uint64_t>(geo.logical_pages())) {
+            std::cerr << "Snapshot Error: snapshot geometry (" << num_blocks_ << " blocks x " << pages_per_block_
+                      << " pages, " << logical_pages_ << " logical pages) does not match the device." << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool has(uint32_t id) const { return find(id) != nullptr; }
+
+    // 섹션이 없으면 ok()가 false인 커서
+    SnapshotCursor section(uint32_t id) const {
+        const Entry* e = find(id);
+        if (!e) return SnapshotCursor();
+        return SnapshotCursor(file_.data() + e->offset, file_.data() + e->offset + e->bytes);
+    }
+
+private:
+    static const size_t ENTRY_SIZE = 24;
+
+    struct Entry {
+        uint32_t id;
+        uint64_t offset;
+        uint64_t bytes;
+    };
+
+    const Entry* find(uint32_t id) const {
+        for (size_t i = 0; i < table_.size(); ++i) {
+            if (table_[i].id == id) return &table_[i];
+        }
+        return nullptr;
+    }
+
+    MappedFile file_;
+    std::vector<Entry> table_;
+    uint64_t num_blocks_;
+    uint32_t pages_per_block_;
+    uint32_t page_size_;
+    uint64_t logical_pages_;
+};
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,142 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// 실행 결과를 저장하지 않고 하나씩 받아 요약하는 스트리밍 통계
+// - RunningStats : 평균/분산 (Welford 온라인 갱신, 큰 값에서도 상쇄 오차가 없음), 최소/최대, 평균의 95% 신뢰 구간
+// - P2Quantile   : 분위수 하나를 표식 5개로 추정 (Jain & Chlamtac의 P² 알고리즘, 메모리 고정)
+// 결과를 넣는 순서가 같으면 값도 비트 단위로 같음 (MonteCarlo.h는 실행 번호 순서대로 넣음)
+
+// 자유도 df인 t 분포의 양측 95% 임계값 (30까지는 표, 그 뒤는 1.96 + 2.5/df 근사, 오차 0.002 이하)
+inline double t_critical_95(long long df) {
+    static const double table[30] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                     2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                     2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (df < 1) return std::numeric_limits<double>::infinity();
+    if (df <= 30) return table[df - 1];
+    return 1.96 + 2.5 / static_cast<double>(df);
+}
+
+class RunningStats {
+public:
+    RunningStats() : n_(0), mean_(0.0), m2_(0.0), min_(0.0), max_(0.0) {}
+
+    void add(double x) {
+        n_++;
+        const double delta = x - mean_;
+        mean_ += delta / n_;
+        m2_ += delta * (x - mean_);
+        if (n_ == 1 || x < min_) min_ = x;
+        if (n_ == 1 || x > max_) max_ = x;
+    }
+
+    long long count() const { return n_; }
+    double mean() const { return mean_; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+    double variance() const { return n_ > 1 ? m2_ / (n_ - 1) : 0.0; } // 표본 분산
+    double stddev() const { return std::sqrt(variance()); }
+
+    // 평균의 95% 신뢰 구간 반폭 (실행이 두 번 미만이면 무한대)
+    double half_width() const {
+        if (n_ < 2) return std::numeric_limits<double>::infinity();
+        return t_critical_95(n_ - 1) * stddev() / std::sqrt(static_cast<double>(n_));
+    }
+
+private:
+    long long n_;
+    double mean_;
+    double m2_; // 평균과의 차이 제곱합
+    double min_, max_;
+};
+
+// P² 분위수 추정: 최소, p/2, p, (1+p)/2, 최대 위치의 표식 5개 높이를 값이 들어올 때마다
+// 포물선(안 되면 직선) 보간으로 옮김. 처음 5개 값은 그대로 모아 두고 정확히 계산
+class P2Quantile {
+public:
+    explicit P2Quantile(double p) : p_(p), count_(0) {
+        const double dn[5] = {0.0, p / 2, p, (1 + p) / 2, 1.0};
+        for (int i = 0; i < 5; ++i) {
+            dn_[i] = dn[i];
+            q_[i] = 0.0;
+            n_[i] = i;
+        }
+        desired_[0] = 0;
+        desired_[1] = 2 * p;
+        desired_[2] = 4 * p;
+        desired_[3] = 2 + 2 * p;
+        desired_[4] = 4;
+    }
+
+    void add(double x) {
+        if (count_ < 5) {
+            q_[count_++] = x;
+            if (count_ == 5) sort_small(q_, 5);
+            return;
+        }
+        count_++;
+        int k; // x가 들어가는 칸 [q_k, q_k+1)
+        if (x < q_[0]) {
+            q_[0] = x;
+            k = 0;
+        } else if (x >= q_[4]) {
+            q_[4] = x;
+            k = 3;
+        } else {
+            k = 0;
+            while (x >= q_[k + 1]) ++k;
+        }
+        for (int i = k + 1; i < 5; ++i) n_[i]++;
+        for (int i = 0; i < 5; ++i) desired_[i] += dn_[i];
+
+        for (int i = 1; i <= 3; ++i) {
+            const double d = desired_[i] - n_[i];
+            if ((d >= 1 && n_[i + 1] - n_[i] > 1) || (d <= -1 && n_[i - 1] - n_[i] < -1)) {
+                const int s = d >= 0 ? 1 : -1;
+                const double qp = parabolic(i, s);
+                q_[i] = q_[i - 1] < qp && qp < q_[i + 1] ? qp : linear(i, s);
+                n_[i] += s;
+            }
+        }
+    }
+
+    double value() const {
+        if (count_ == 0) return 0.0;
+        if (count_ >= 5) return q_[2];
+        double sorted[5];
+        std::copy(q_, q_ + count_, sorted);
+        sort_small(sorted, static_cast<int>(count_));
+        return sorted[static_cast<int>(p_ * (count_ - 1) + 0.5)];
+    }
+
+private:
+    // 값 5개 이하 삽입 정렬 (std::sort는 고정 크기 배열에서 -Warray-bounds 경고를 냄)
+    static void sort_small(double* a, int n) {
+        for (int i = 1; i < n; ++i) {
+            const double x = a[i];
+            int j = i;
+            for (; j > 0 && a[j - 1] > x; --j) a[j] = a[j - 1];
+            a[j] = x;
+        }
+    }
+
+    double parabolic(int i, int s) const {
+        const double span = n_[i + 1] - n_[i - 1];
+        return q_[i] + s / span *
+               ((n_[i] - n_[i - 1] + s) * (q_[i + 1] - q_[i]) / (n_[i + 1] - n_[i]) +
+                (n_[i + 1] - n_[i] - s) * (q_[i] - q_[i - 1]) / (n_[i] - n_[i - 1]));
+    }
+    double linear(int i, int s) const { return q_[i] + s * (q_[i + s] - q_[i]) / (n_[i + s] - n_[i]); }
+
+    double p_;
+    long long count_;
+    double q_[5];       // 표식 높이
+    double n_[5];       // 표식의 실제 위치
+    double desired_[5]; // 표식의 원하는 위치
+    double dn_[5];      // 값 하나마다 원하는 위치가 움직이는 양
+};
+
+#endif // STATISTICS_H
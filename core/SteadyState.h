@@ -0,0 +1,159 @@
+#ifndef STEADY_STATE_H
+#define STEADY_STATE_H
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// 창(window) 단위 WAF 측정과 정상 상태(steady state) 판정
+// - 호스트 쓰기 window개마다 그 창의 WAF(= 창 동안의 NAND 쓰기 / 호스트 쓰기)를 기록
+// - 워밍업 구간은 MSER(Marginal Standard Error Rule)로 자름: 창 d부터 끝까지의 WAF 분산 / (남은 창 수)^2 이
+//   가장 작은 d를 고르고, d가 판정 가능한 창들의 앞쪽 절반 안에 있으면 d부터를 정상 상태로 봄
+//   (뒤쪽 절반이면 아직 WAF가 움직이는 중. 천천히 오르는 구간은 분산을 키우므로 잘라 냄)
+//   - 빈 장치에서는 처음 논리 용량만큼 쓰는 동안 GC가 없어 WAF가 1로 평평하므로 min_warmup(호스트 쓰기)
+//     전의 창은 정상 상태에 넣지 않음 (드라이버는 길들이지 않은 장치면 논리 용량을 넘겨줌)
+//   - 정상 상태 구간은 창이 늘 때마다 다시 고르고, 최소 detect개의 창이 있어야 함
+// - 보고하는 WAF는 정상 상태 구간의 NAND 쓰기 / 호스트 쓰기
+// - precision이 0보다 크면 정상 상태 창 평균의 95% 신뢰 구간 반폭이 평균의 precision 이하가 되는 순간 실행을 멈춤
+//   (창을 배치 평균으로 보고 창 사이의 상관은 무시)
+
+struct SteadyStateOptions {
+    long long window;  // 창 크기 (호스트 쓰기 수, 0이면 끔)
+    int detect;        // 정상 상태 구간의 최소 창 수
+    double precision;  // 조기 종료 기준 (신뢰 구간 반폭 / 평균, 0이면 끝까지 실행)
+
+    SteadyStateOptions() : window(0), detect(10), precision(0.0) {}
+
+    bool enabled() const { return window > 0; }
+};
+
+// 명령행 인자에서 정상 상태 설정을 읽음 (모르는 인자는 건너뜀)
+//   --waf-window N  --steady-windows N  --steady-precision X
+inline bool parse_steady_state_args(int argc, char** argv, SteadyStateOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--waf-window") == 0) {
+            opt.window = std::strtoll(value, nullptr, 10); ++i;
+        } else if (std::strcmp(key, "--steady-windows") == 0) {
+            opt.detect = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--steady-precision") == 0) {
+            opt.precision = std::atof(value); ++i;
+        }
+    }
+    if (opt.window < 0 || opt.detect < 2 || opt.precision < 0) {
+        std::cerr << "Steady State Error: --waf-window and --steady-precision must not be negative"
+                  << " and --steady-windows must be at least 2." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 실행 하나의 창별 WAF를 모으며 정상 상태를 판정 (실행마다 하나씩)
+class SteadyStateTracker {
+public:
+    // min_warmup: 이 호스트 쓰기 수를 넘기 전의 창은 정상 상태 판정에 쓰지 않음
+    SteadyStateTracker(const SteadyStateOptions& opt, long long min_warmup)
+        : opt_(opt), min_warmup_(min_warmup), first_eligible_(-1), last_host_(0), last_nand_(0),
+          next_sample_(opt.window), steady_from_(-1) {}
+
+    // 누적 호스트/NAND 쓰기 수를 넘겨줌 (창 경계를 지났을 때만 일을 함)
+    // 정해진 정밀도로 정상 상태 WAF를 얻었으면 true (실행을 멈춰도 됨)
+    bool sample(long long host_writes, long long nand_writes) {
+        if (host_writes < next_sample_) return false;
+        host_.push_back(host_writes - last_host_);
+        nand_.push_back(nand_writes - last_nand_);
+        last_host_ = host_writes;
+        last_nand_ = nand_writes;
+        next_sample_ = host_writes + opt_.window;
+
+        const int n = num_windows();
+        if (first_eligible_ == -1 && host_writes - host_.back() >= min_warmup_) first_eligible_ = n - 1;
+        steady_from_ = mser_truncation();
+        return opt_.precision > 0 && steady() && relative_half_width() <= opt_.precision;
+    }
+
+    bool steady() const { return steady_from_ != -1; }
+    int num_windows() const { return static_cast<int>(host_.size()); }
+
+    // 정상 상태 전까지의 호스트 쓰기 수 (정상 상태가 아니면 전부)
+    long long warmup_host_writes() const {
+        long long sum = 0;
+        const int end = steady() ? steady_from_ : num_windows();
+        for (int i = 0; i < end; ++i) sum += host_[i];
+        return sum;
+    }
+
+    // 정상 상태 구간의 WAF (정상 상태에 닿지 못했으면 마지막 detect개 창의 WAF를 최선의 추정으로 씀)
+    double steady_waf() const {
+        const int n = num_windows();
+        int from = steady() ? steady_from_ : (n > opt_.detect ? n - opt_.detect : 0);
+        long long h = 0, w = 0;
+        for (int i = from; i < n; ++i) {
+            h += host_[i];
+            w += nand_[i];
+        }
+        return h == 0 ? 0.0 : static_cast<double>(w) / h;
+    }
+
+    // 정상 상태 창 평균의 95% 신뢰 구간 반폭 / 평균 (창이 두 개 미만이면 무한대)
+    double relative_half_width() const {
+        const int from = steady() ? steady_from_ : 0;
+        const int n = num_windows();
+        if (n - from < 2) return INFINITY;
+        double mean, stddev;
+        window_stats(from, n, mean, stddev);
+        return mean > 0 ? 1.96 * stddev / std::sqrt(static_cast<double>(n - from)) / mean : INFINITY;
+    }
+
+private:
+    double window_waf(int i) const { return static_cast<double>(nand_[i]) / host_[i]; }
+
+    // MSER 절단점 (정상 상태가 시작하는 창 번호, 아직 판정할 수 없으면 -1)
+    // 뒤에서부터 누적합으로 훑으므로 창 수에 비례
+    int mser_truncation() const {
+        const int n = num_windows();
+        if (first_eligible_ == -1 || n - first_eligible_ < 2 * opt_.detect) return -1;
+        double sum = 0.0, sum_sq = 0.0, best_stat = INFINITY;
+        int best = -1;
+        for (int d = n - 1; d >= first_eligible_; --d) {
+            const double x = window_waf(d);
+            sum += x;
+            sum_sq += x * x;
+            const double k = n - d;
+            if (k < opt_.detect) continue;
+            const double stat = (sum_sq - sum * sum / k) / (k * k);
+            if (stat <= best_stat) {
+                best_stat = stat;
+                best = d;
+            }
+        }
+        return best <= first_eligible_ + (n - first_eligible_) / 2 ? best : -1;
+    }
+
+    // 창 [from, to)의 WAF 평균과 표본 표준편차
+    void window_stats(int from, int to, double& mean, double& stddev) const {
+        double sum = 0.0, sum_sq = 0.0;
+        for (int i = from; i < to; ++i) {
+            double waf = window_waf(i);
+            sum += waf;
+            sum_sq += waf * waf;
+        }
+        const int k = to - from;
+        mean = sum / k;
+        double var = k > 1 ? (sum_sq - k * mean * mean) / (k - 1) : 0.0;
+        stddev = var > 0 ? std::sqrt(var) : 0.0;
+    }
+
+    SteadyStateOptions opt_;
+    long long min_warmup_;
+    int first_eligible_; // min_warmup 뒤에 시작한 첫 창 번호 (-1이면 아직)
+    std::vector<long long> host_, nand_; // 창별 호스트 / NAND 쓰기 수
+    long long last_host_, last_nand_;
+    long long next_sample_;
+    int steady_from_; // 정상 상태가 시작된 창 번호 (-1이면 아직)
+};
+
+#endif // STEADY_STATE_H
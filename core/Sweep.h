@@ -0,0 +1,331 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Rng.h"
+
+// 파라미터 스윕: 명령행 옵션 몇 개를 여러 값으로 바꿔 가며 같은 실험을 반복하고 결과를 표 하나(CSV / JSON)로 모음
+// - 축(axis)은 기존 명령행 옵션 이름과 값: --sweep op=0.07,0.15,0.25  --sweep hot-threshold=6,11,16
+//   점 하나는 원래 명령행 뒤에 "--op 0.07 --hot-threshold 11"을 덧붙여 실행한 것과 같음
+//   (축이 실제로 결과에 닿는지는 옵션 몫: 예를 들어 --hot-threshold는 --classifier none / host에서는 쓰이지 않음)
+//   (parse_*_args는 같은 옵션이 여러 번 오면 마지막 값을 쓰므로 기본 명령행의 값을 덮어씀)
+// - 격자(grid): 모든 축 값의 조합 (마지막 축이 가장 빨리 바뀜)
+// - 무작위 탐색(--sweep-random N): 점 N개를 뽑음. 축을 lo:hi로 주면 그 범위에서 고르게
+//   (양 끝이 모두 정수면 정수), 목록으로 주면 목록에서 하나씩 고름. 같은 --sweep-seed면 같은 점들
+// - 모든 점이 같은 마스터 시드(--seed)를 쓰므로 점 사이의 비교는 공통 난수 비교
+
+// 축 하나 (값 목록 또는 무작위 탐색용 범위)
+struct SweepAxis {
+    std::string name;                // 옵션 이름 (앞의 "--" 없이)
+    std::vector<std::string> values; // 값 목록 (범위 축이면 비어 있음)
+    bool range;                      // lo:hi 범위인지
+    double lo, hi;
+    bool integer;                    // 범위의 양 끝이 모두 정수인지
+
+    SweepAxis() : range(false), lo(0.0), hi(0.0), integer(false) {}
+};
+
+struct SweepOptions {
+    std::vector<SweepAxis> axes;
+    int random_points;    // 0이면 격자, 아니면 무작위로 뽑을 점 수
+    uint64_t seed;        // 무작위 탐색의 점을 뽑는 시드 (실행 난수와는 별개)
+    std::string out_path; // 결과 표 경로 (.json이면 JSON, 그 밖에는 CSV, 비어 있으면 표준 출력에 CSV)
+
+    SweepOptions() : random_points(0), seed(1) {}
+
+    bool enabled() const { return !axes.empty(); }
+    bool json() const {
+        return out_path.size() >= 5 && out_path.compare(out_path.size() - 5, 5, ".json") == 0;
+    }
+};
+
+// 점마다 덮어쓰면 스윕 자체가 망가지는 옵션 (병렬화, 시드, 스냅샷 저장, 트레이스 재생은 스윕이 정함)
+inline bool sweep_axis_allowed(const std::string& name) {
+    static const char* const reserved[] = {"threads", "seed", "save-snapshot", "trace", "sweep-random", "sweep-seed", "sweep-out"};
+    for (const char* r : reserved) {
+        if (name == r) return false;
+    }
+    return true;
+}
+
+// 축 지정 "name=v1,v2,..." 또는 "name=lo:hi"를 읽음 (잘못되면 false)
+inline bool parse_sweep_axis(const std::string& spec, SweepAxis& axis) {
+    const size_t eq = spec.find('=');
+    if (eq == std::string::npos || eq == 0 || eq + 1 == spec.size()) return false;
+    axis.name = spec.substr(0, eq);
+    for (char c : axis.name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-') return false;
+    }
+    const std::string rest = spec.substr(eq + 1);
+    const size_t colon = rest.find(':');
+    if (colon != std::string::npos) {
+        const std::string lo = rest.substr(0, colon), hi = rest.substr(colon + 1);
+        char* end_lo = nullptr;
+        char* end_hi = nullptr;
+        axis.lo = std::strtod(lo.c_str(), &end_lo);
+        axis.hi = std::strtod(hi.c_str(), &end_hi);
+        if (lo.empty() || hi.empty() || *end_lo != '\0' || *end_hi != '\0' || axis.lo > axis.hi) return false;
+        axis.range = true;
+        axis.integer = lo.find_first_of(".eE") == std::string::npos && hi.find_first_of(".eE") == std::string::npos;
+        return true;
+    }
+    size_t start = 0;
+    while (start <= rest.size()) {
+        size_t comma = rest.find(',', start);
+        if (comma == std::string::npos) comma = rest.size();
+        if (comma == start) return false; // 빈 값
+        axis.values.push_back(rest.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return true;
+}
+
+// 명령행 인자에서 스윕 설정을 읽음 (모르는 인자는 건너뜀)
+//   --sweep NAME=V1,V2,...|NAME=LO:HI (여러 번)  --sweep-random N  --sweep-seed N  --sweep-out PATH
+inline bool parse_sweep_args(int argc, char** argv, SweepOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--sweep") == 0) {
+            SweepAxis axis;
+            if (!parse_sweep_axis(value, axis)) {
+                std::cerr << "Sweep Error: bad axis '" << value << "' (NAME=V1,V2,... or NAME=LO:HI)." << std::endl;
+                return false;
+            }
+            if (!sweep_axis_allowed(axis.name)) {
+                std::cerr << "Sweep Error: --" << axis.name << " cannot be swept." << std::endl;
+                return false;
+            }
+            for (const SweepAxis& other : opt.axes) {
+                if (other.name == axis.name) {
+                    std::cerr << "Sweep Error: axis '" << axis.name << "' given twice." << std::endl;
+                    return false;
+                }
+            }
+            opt.axes.push_back(axis);
+            ++i;
+        } else if (std::strcmp(key, "--sweep-random") == 0) {
+            opt.random_points = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--sweep-seed") == 0) {
+            opt.seed = std::strtoull(value, nullptr, 10); ++i;
+        } else if (std::strcmp(key, "--sweep-out") == 0) {
+            opt.out_path = value; ++i;
+        }
+    }
+    if (opt.random_points < 0) {
+        std::cerr << "Sweep Error: --sweep-random must not be negative." << std::endl;
+        return false;
+    }
+    if (opt.random_points == 0) {
+        for (const SweepAxis& axis : opt.axes) {
+            if (axis.range) {
+                std::cerr << "Sweep Error: range axis '" << axis.name << "' needs --sweep-random N." << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 스윕의 점들 (점마다 축 순서대로 값 문자열, 점이 너무 많으면 이유를 출력하고 false)
+inline bool sweep_points(const SweepOptions& opt, std::vector<std::vector<std::string> >& points) {
+    const size_t MAX_POINTS = 1000000;
+    points.clear();
+    if (opt.random_points > 0) {
+        Rng rng(opt.seed);
+        char buf[32];
+        for (int p = 0; p < opt.random_points; ++p) {
+            std::vector<std::string> point;
+            for (const SweepAxis& axis : opt.axes) {
+                if (!axis.range) {
+                    point.push_back(axis.values[rng.below(axis.values.size())]);
+                } else if (axis.integer) {
+                    const long long lo = static_cast<long long>(axis.lo);
+                    const uint64_t span = static_cast<uint64_t>(static_cast<long long>(axis.hi) - lo) + 1;
+                    std::snprintf(buf, sizeof(buf), "%lld", lo + static_cast<long long>(rng.below(span)));
+                    point.push_back(buf);
+                } else {
+                    std::snprintf(buf, sizeof(buf), "%.6g", axis.lo + (axis.hi - axis.lo) * rng.uniform());
+                    point.push_back(buf);
+                }
+            }
+            points.push_back(point);
+        }
+        return true;
+    }
+
+    size_t total = 1;
+    for (const SweepAxis& axis : opt.axes) {
+        total *= axis.values.size();
+        if (total > MAX_POINTS) {
+            std::cerr << "Sweep Error: the grid has more than " << MAX_POINTS << " points." << std::endl;
+            return false;
+        }
+    }
+    std::vector<size_t> digit(opt.axes.size(), 0); // 축별 현재 값 번호 (마지막 축부터 올림)
+    for (size_t p = 0; p < total; ++p) {
+        std::vector<std::string> point;
+        for (size_t a = 0; a < opt.axes.size(); ++a) point.push_back(opt.axes[a].values[digit[a]]);
+        points.push_back(point);
+        for (size_t a = opt.axes.size(); a-- > 0;) {
+            if (++digit[a] < opt.axes[a].values.size()) break;
+            digit[a] = 0;
+        }
+    }
+    return true;
+}
+
+// 점 하나의 요약 (run_simulation이 채움, 결과 표의 한 행)
+struct SimulationSummary {
+    bool ok;              // 설정이 잘못돼 실행하지 못했으면 false (나머지 값은 0)
+    int runs;             // 끝낸 실행 수
+    double waf_mean, waf_ci, waf_min, waf_max, waf_p50; // waf_ci = 평균의 95% 신뢰 구간 반폭
+    double gc_per_run;
+    double host_writes_per_run, nand_writes_per_run;
+    double erase_min, erase_max, erase_mean, erase_stddev; // 블록별 지우기 횟수 (실행별 요약의 평균)
+    double seconds;       // 실행들에 걸린 벽시계 시간
+    double ops_per_sec;   // 시뮬레이터 처리량 (초당 호스트 요청 수, 스레드 전체)
+
+    SimulationSummary()
+        : ok(false), runs(0), waf_mean(0), waf_ci(0), waf_min(0), waf_max(0), waf_p50(0), gc_per_run(0),
+          host_writes_per_run(0), nand_writes_per_run(0), erase_min(0), erase_max(0), erase_mean(0),
+          erase_stddev(0), seconds(0), ops_per_sec(0) {}
+};
+
+// 표의 측정값 열 (CSV 머리글 / JSON 키 순서)
+inline void sweep_metric_values(const SimulationSummary& s, double values[15]) {
+    const double v[15] = {static_cast<double>(s.runs), s.waf_mean, s.waf_ci, s.waf_min, s.waf_max, s.waf_p50,
+                          s.gc_per_run, s.host_writes_per_run, s.nand_writes_per_run, s.erase_min, s.erase_max,
+                          s.erase_mean, s.erase_stddev, s.seconds, s.ops_per_sec};
+    for (int k = 0; k < 15; ++k) values[k] = v[k];
+}
+
+static const char* const SWEEP_METRICS[15] = {"runs", "waf_mean", "waf_ci95", "waf_min", "waf_max", "waf_p50",
+                                             "gc_per_run", "host_writes_per_run", "nand_writes_per_run",
+                                             "erase_min", "erase_max", "erase_mean", "erase_stddev",
+                                             "seconds", "ops_per_sec"};
+
+// 문자열 전체가 JSON 숫자 문법에 맞는지 (따옴표 없이 쓸지 정함)
+//   -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?  (strtod가 받는 inf, nan, 0x10, 1. 등은 문자열로 씀)
+inline bool sweep_is_number(const std::string& s) {
+    size_t i = 0;
+    const size_t n = s.size();
+    auto digits = [&]() {
+        const size_t start = i;
+        while (i < n && std::isdigit(static_cast<unsigned char>(s[i]))) ++i;
+        return i > start;
+    };
+    if (i < n && s[i] == '-') ++i;
+    if (i < n && s[i] == '0') ++i;
+    else if (!digits()) return false;
+    if (i < n && s[i] == '.') {
+        ++i;
+        if (!digits()) return false;
+    }
+    if (i < n && (s[i] == 'e' || s[i] == 'E')) {
+        ++i;
+        if (i < n && (s[i] == '+' || s[i] == '-')) ++i;
+        if (!digits()) return false;
+    }
+    return i == n;
+}
+
+// JSON 문자열 리터럴로 씀 (따옴표 포함, ", \, 제어 문자는 이스케이프)
+inline void write_json_string(std::ostream& out, const std::string& s) {
+    out << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+            out << buf;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// 결과 표를 씀 (점마다 한 행: 점 번호, 축 값들, 상태, 측정값들)
+inline void write_sweep_csv(std::ostream& out, const SweepOptions& opt, const std::vector<std::vector<std::string> >& points,
+                            const std::vector<SimulationSummary>& results) {
+    out << "point";
+    for (const SweepAxis& axis : opt.axes) out << "," << axis.name;
+    out << ",status";
+    for (const char* m : SWEEP_METRICS) out << "," << m;
+    out << "\n";
+    char buf[32];
+    for (size_t p = 0; p < points.size(); ++p) {
+        out << p;
+        for (const std::string& v : points[p]) out << "," << v;
+        out << "," << (results[p].ok ? "ok" : "error");
+        double values[15];
+        sweep_metric_values(results[p], values);
+        for (double v : values) {
+            std::snprintf(buf, sizeof(buf), "%.6g", v);
+            out << "," << buf;
+        }
+        out << "\n";
+    }
+}
+
+inline void write_sweep_json(std::ostream& out, const SweepOptions& opt, const std::vector<std::vector<std::string> >& points,
+                             const std::vector<SimulationSummary>& results) {
+    out << "{\n  \"axes\": [";
+    for (size_t a = 0; a < opt.axes.size(); ++a) {
+        out << (a ? ", " : "");
+        write_json_string(out, opt.axes[a].name);
+    }
+    out << "],\n  \"points\": [\n";
+    char buf[32];
+    for (size_t p = 0; p < points.size(); ++p) {
+        out << "    {\"point\": " << p << ", \"params\": {";
+        for (size_t a = 0; a < opt.axes.size(); ++a) {
+            const std::string& v = points[p][a];
+            out << (a ? ", " : "");
+            write_json_string(out, opt.axes[a].name);
+            out << ": ";
+            if (sweep_is_number(v)) out << v;
+            else write_json_string(out, v);
+        }
+        out << "}, \"status\": \"" << (results[p].ok ? "ok" : "error") << "\"";
+        double values[15];
+        sweep_metric_values(results[p], values);
+        for (int k = 0; k < 15; ++k) {
+            if (std::isfinite(values[k])) std::snprintf(buf, sizeof(buf), "%.6g", values[k]);
+            else std::snprintf(buf, sizeof(buf), "null"); // 실행이 하나뿐이면 신뢰 구간이 무한대
+            out << ", \"" << SWEEP_METRICS[k] << "\": " << buf;
+        }
+        out << "}" << (p + 1 < points.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// 결과 표를 opt.out_path에 씀 (비어 있으면 표준 출력에 CSV, 파일을 열 수 없으면 false)
+inline bool write_sweep_table(const SweepOptions& opt, const std::vector<std::vector<std::string> >& points,
+                              const std::vector<SimulationSummary>& results) {
+    if (opt.out_path.empty()) {
+        write_sweep_csv(std::cout, opt, points, results);
+        return true;
+    }
+    std::ofstream file(opt.out_path.c_str());
+    if (!file) {
+        std::cerr << "Sweep Error: cannot write " << opt.out_path << "." << std::endl;
+        return false;
+    }
+    if (opt.json()) write_sweep_json(file, opt, points, results);
+    else write_sweep_csv(file, opt, points, results);
+    return static_cast<bool>(file);
+}
+
+#endif // SWEEP_H
@@ -0,0 +1,397 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "NandFlash.h"
+#include "Workload.h"
+#include "GcSchedule.h"
+
+// NAND 타이밍 모델 + 이산 사건(discrete-event) 엔진
+//
+// - FTL은 그대로 "기능 모델"로 동작하고, 호스트 요청 하나가 만든 NAND 명령(read/program/erase)을
+//   NandFlash의 명령 기록으로 모은 뒤 이 파일의 타이밍 모델이 시간을 매김
+// - 블록은 (채널, 다이, 플레인)에 줄무늬로 배치: block % 유닛 수 -> 채널이 가장 빨리 바뀜
+// - 플레인마다 셀 배열이, 채널마다 데이터 버스가 하나씩 있고 각자 "언제 비는지"만 기억
+//   (플레인끼리는 완전히 독립 = 이상적인 멀티 플레인, 같은 채널의 다이들은 버스를 나눠 씀)
+// - 한 호스트 요청의 NAND 명령은 기록된 순서대로 하나씩 실행 (GC 복사 read -> program -> erase -> 호스트 program)
+//   -> GC를 일으킨 쓰기는 GC 작업이 끝날 때까지 기다리고, 그동안 같은 플레인/채널을 쓰는 다른 요청도 밀림
+// - 시간 단위는 나노초
+
+// 타이밍 설정 (명령행에서는 마이크로초로 받음)
+struct TimingConfig {
+    bool enabled;
+    long long t_read;    // tR: 셀 -> 페이지 레지스터
+    long long t_prog;    // tPROG: 페이지 레지스터 -> 셀
+    long long t_erase;   // tBERS: 블록 지우기
+    long long t_xfer;    // 페이지 하나를 채널 버스로 옮기는 시간
+    int channels;
+    int dies_per_channel;
+    int planes_per_die;
+    int queue_depth;     // 동시에 처리 중인 호스트 요청 수 (닫힌 루프)
+
+    TimingConfig()
+        : enabled(false), t_read(50000), t_prog(500000), t_erase(3000000), t_xfer(5000),
+          channels(4), dies_per_channel(2), planes_per_die(2), queue_depth(32) {}
+
+    int num_units() const { return channels * dies_per_channel * planes_per_die; }
+};
+
+// 명령행 인자에서 타이밍 설정을 읽음 (모르는 인자는 건너뜀)
+//   --timing (켜기)  --tR US  --tPROG US  --tBERS US  --xfer US
+//   --channels N  --dies N  --planes N  --qd N
+inline bool parse_timing_args(int argc, char** argv, TimingConfig& cfg) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--timing") == 0) {
+            cfg.enabled = true;
+        }
+    }
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--tR") == 0) {
+            cfg.t_read = static_cast<long long>(std::atof(value) * 1000); ++i;
+        } else if (std::strcmp(key, "--tPROG") == 0) {
+            cfg.t_prog = static_cast<long long>(std::atof(value) * 1000); ++i;
+        } else if (std::strcmp(key, "--tBERS") == 0) {
+            cfg.t_erase = static_cast<long long>(std::atof(value) * 1000); ++i;
+        } else if (std::strcmp(key, "--xfer") == 0) {
+            cfg.t_xfer = static_cast<long long>(std::atof(value) * 1000); ++i;
+        } else if (std::strcmp(key, "--channels") == 0) {
+            cfg.channels = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--dies") == 0) {
+            cfg.dies_per_channel = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--planes") == 0) {
+            cfg.planes_per_die = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--qd") == 0) {
+            cfg.queue_depth = std::atoi(value); ++i;
+        }
+    }
+    if (cfg.channels < 1 || cfg.dies_per_channel < 1 || cfg.planes_per_die < 1 || cfg.queue_depth < 1) {
+        std::cerr << "Timing Error: channels, dies, planes and queue depth must be at least 1." << std::endl;
+        return false;
+    }
+    if (cfg.t_read < 0 || cfg.t_prog < 0 || cfg.t_erase < 0 || cfg.t_xfer < 0) {
+        std::cerr << "Timing Error: NAND timings must not be negative." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 로그-선형 지연 시간 히스토그램 (HDR 히스토그램과 같은 방식)
+// - 2의 거듭제곱 구간마다 SUB개로 나눠서 상대 오차 1/SUB 이내, 메모리는 고정 크기
+// - 기록은 비트 연산 몇 번, 백분위는 버킷을 한 번 훑음
+class LatencyHistogram {
+public:
+    static const int SUB_BITS = 5;
+    static const int SUB = 1 << SUB_BITS;
+    static const int NUM_BUCKETS = (64 - SUB_BITS + 1) * SUB;
+
+    LatencyHistogram() : counts_(NUM_BUCKETS, 0), count_(0), sum_(0), max_(0) {}
+
+    void record(long long value) {
+        if (value < 0) value = 0;
+        counts_[bucket_of(static_cast<uint64_t>(value))]++;
+        count_++;
+        sum_ += static_cast<double>(value);
+        if (value > max_) max_ = value;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < NUM_BUCKETS; ++i) counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        if (other.max_ > max_) max_ = other.max_;
+    }
+
+    long long count() const { return count_; }
+    long long max() const { return max_; }
+    double mean() const { return count_ == 0 ? 0.0 : sum_ / count_; }
+
+    // p (0 ~ 1) 백분위 값 (해당 버킷의 상한, 최댓값을 넘지 않음)
+    long long percentile(double p) const {
+        if (count_ == 0) return 0;
+        long long rank = static_cast<long long>(p * count_);
+        if (rank >= count_) rank = count_ - 1;
+        long long seen = 0;
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            seen += counts_[i];
+            if (seen > rank) return std::min(static_cast<long long>(upper_of(i)), max_);
+        }
+        return max_;
+    }
+
+private:
+    static int bucket_of(uint64_t v) {
+        if (v < static_cast<uint64_t>(SUB)) return static_cast<int>(v);
+        int msb = 63 - __builtin_clzll(v);
+        int shift = msb - SUB_BITS;
+        return (shift + 1) * SUB + static_cast<int>((v >> shift) - SUB);
+    }
+    static uint64_t upper_of(int bucket) {
+        if (bucket < SUB) return static_cast<uint64_t>(bucket);
+        int shift = bucket / SUB - 1;
+        uint64_t sub = static_cast<uint64_t>(bucket % SUB + SUB);
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::vector<long long> counts_;
+    long long count_;
+    double sum_;
+    long long max_;
+};
+
+// 사건 큐: (시각, 등록 순서)가 가장 이른 사건부터 꺼내는 이진 최소 힙
+// (사건은 16바이트 POD라 힙 연산이 캐시 안에서 끝남, 같은 시각이면 먼저 넣은 사건이 먼저)
+class EventQueue {
+public:
+    struct Event {
+        long long time;
+        uint32_t seq;
+        int id;
+    };
+
+    EventQueue() : seq_(0) {}
+
+    void push(long long time, int id) {
+        heap_.push_back(Event{time, seq_++, id});
+        std::push_heap(heap_.begin(), heap_.end(), later);
+    }
+
+    Event pop() {
+        std::pop_heap(heap_.begin(), heap_.end(), later);
+        Event e = heap_.back();
+        heap_.pop_back();
+        return e;
+    }
+
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+
+private:
+    static bool later(const Event& a, const Event& b) {
+        return a.time != b.time ? a.time > b.time : a.seq > b.seq;
+    }
+
+    std::vector<Event> heap_;
+    uint32_t seq_;
+};
+
+// 플레인/채널 자원 예약기
+// - issue(op, now): 자원이 비는 대로 명령을 실행하고 끝나는 시각을 돌려줌 (사건 시각 순서대로 부르면 자원별 FCFS)
+class NandTiming {
+public:
+    explicit NandTiming(const TimingConfig& cfg)
+        : cfg_(cfg), unit_free_(cfg.num_units(), 0), channel_free_(cfg.channels, 0), busy_(0) {}
+
+    long long issue(const NandOp& op, long long now) {
+        int unit = op.block % cfg_.num_units();
+        int channel = unit % cfg_.channels;
+        long long& plane = unit_free_[unit];
+        long long& bus = channel_free_[channel];
+        long long end = now;
+        switch (op.type) {
+        case NandOpType::READ: {
+            // 셀 읽기 후 버스로 내보낼 때까지 페이지 레지스터를 잡고 있음
+            long long sensed = std::max(now, plane) + cfg_.t_read;
+            end = std::max(sensed, bus) + cfg_.t_xfer;
+            bus = end;
+            plane = end;
+            busy_ += cfg_.t_read;
+            break;
+        }
+        case NandOpType::PROGRAM: {
+            // 버스로 데이터를 넣은 뒤 셀에 기록
+            long long loaded = std::max(std::max(now, plane), bus) + cfg_.t_xfer;
+            end = loaded + cfg_.t_prog;
+            bus = loaded;
+            plane = end;
+            busy_ += cfg_.t_prog;
+            break;
+        }
+        case NandOpType::ERASE:
+            end = std::max(now, plane) + cfg_.t_erase;
+            plane = end;
+            busy_ += cfg_.t_erase;
+            break;
+        }
+        return end;
+    }
+
+    // 셀 배열이 실제로 일한 시간의 합 (플레인 이용률 계산용)
+    long long busy_time() const { return busy_; }
+
+private:
+    TimingConfig cfg_;
+    std::vector<long long> unit_free_;    // 플레인별로 다음 명령을 받을 수 있는 시각
+    std::vector<long long> channel_free_; // 채널 버스가 비는 시각
+    long long busy_;
+};
+
+// 시간 측정 결과 (여러 실행을 merge로 합칠 수 있음)
+struct TimingStats {
+    LatencyHistogram read_latency;
+    LatencyHistogram write_latency;
+    long long elapsed;    // 첫 요청 제출부터 마지막 완료까지
+    long long completed;  // 완료된 호스트 요청 수
+    long long bytes;      // 호스트가 주고받은 데이터 양
+    long long events;     // 처리한 사건 수
+    long long plane_busy; // 플레인들이 일한 시간 합
+
+    TimingStats() : elapsed(0), completed(0), bytes(0), events(0), plane_busy(0) {}
+
+    void merge(const TimingStats& other) {
+        read_latency.merge(other.read_latency);
+        write_latency.merge(other.write_latency);
+        elapsed += other.elapsed;
+        completed += other.completed;
+        bytes += other.bytes;
+        events += other.events;
+        plane_busy += other.plane_busy;
+    }
+};
+
+// 워크로드 요청 num_ops개를 큐 깊이 queue_depth의 닫힌 루프로 제출하며 시간을 매김
+// - 요청이 하나 끝나면 같은 슬롯으로 바로 다음 요청을 제출
+// - BACKGROUND GC 스케줄에 쉬는 구간이 있으면(idle_every > 0) 그만큼 제출한 뒤 진행 중인 요청이 모두 끝나기를 기다려
+//   ftl.idle()의 NAND 명령을 별도 슬롯에서 실행하고, 페이지 idle_pages개를 옮길 만큼 쉰 뒤 제출을 재개
+//   (쉬는 구간이 짧으면 백그라운드 GC가 다음 호스트 요청을 밀어냄)
+// - FTL 상태는 제출 순서대로 바뀌므로 같은 워크로드면 WAF는 타이밍 없이 돌린 것과 같음
+// - FTL 쓰기가 실패하면 그 자리에서 제출을 멈추고 false
+template <typename FtlT>
+bool run_timed(FtlT& ftl, Workload& workload, long long num_ops, const TimingConfig& cfg, TimingStats& stats) {
+    struct Slot {
+        OpType type;
+        long long submitted;
+        size_t next;
+        std::vector<NandOp> ops;
+    };
+
+    const long long page_size = ftl.geometry().page_size;
+    const int idle_every = ftl.gc_schedule().mode == GcMode::BACKGROUND ? ftl.gc_schedule().idle_every : 0;
+    const long long idle_gap = ftl.gc_schedule().idle_pages * (cfg.t_read + cfg.t_prog + 2 * cfg.t_xfer);
+    const int background = cfg.queue_depth; // 백그라운드 GC 슬롯 번호
+    const int resume = cfg.queue_depth + 1; // 쉬는 구간이 끝났음을 알리는 사건 번호
+    NandTiming nand(cfg);
+    EventQueue events;
+    std::vector<Slot> slots(cfg.queue_depth + 1);
+    long long issued = 0;
+    long long outstanding = 0;
+    long long next_idle = idle_every > 0 ? idle_every : -1;
+    bool pausing = false;
+    long long now = 0;
+    bool ok = true;
+
+    // 슬롯에 새 요청을 제출: FTL을 실행하면서 생긴 NAND 명령을 슬롯에 모아둠
+    auto submit = [&](int id, long long t) {
+        Slot& slot = slots[id];
+        const Op& op = workload.next();
+        slot.type = op.type;
+        slot.submitted = t;
+        slot.next = 0;
+        slot.ops.clear();
+        ftl.set_nand_op_log(&slot.ops);
+        if (op.type == OpType::WRITE) {
+            ok = ftl.write(op.lpn, op.stream);
+        } else if (op.type == OpType::TRIM) {
+            ok = ftl.trim(op.lpn, op.count);
+        } else {
+            ftl.read(op.lpn);
+        }
+        ftl.set_nand_op_log(nullptr);
+        issued++;
+        outstanding++;
+        events.push(t, id);
+    };
+    // 비어있는 슬롯마다 제출 (쉬는 구간에 들어갈 차례면 멈춤)
+    auto fill = [&](int id, long long t) {
+        if (issued >= num_ops || !ok) return;
+        if (issued == next_idle) {
+            pausing = true;
+            next_idle += idle_every;
+        }
+        if (!pausing) submit(id, t);
+    };
+
+    for (int id = 0; id < cfg.queue_depth; ++id) {
+        fill(id, 0);
+    }
+
+    while (!events.empty()) {
+        EventQueue::Event e = events.pop();
+        now = e.time;
+        stats.events++;
+        if (e.id == resume) {
+            pausing = false;
+            for (int id = 0; id < cfg.queue_depth; ++id) fill(id, now);
+            continue;
+        }
+        Slot& slot = slots[e.id];
+        if (slot.next < slot.ops.size()) {
+            // 이 요청의 다음 NAND 명령을 시작 (끝나는 시각에 다시 깨어남)
+            events.push(nand.issue(slot.ops[slot.next++], now), e.id);
+            continue;
+        }
+        if (e.id == background) continue;
+        // 요청 완료
+        outstanding--;
+        long long latency = now - slot.submitted;
+        stats.completed++;
+        if (slot.type == OpType::WRITE) {
+            stats.write_latency.record(latency);
+            stats.bytes += page_size;
+        } else if (slot.type == OpType::READ) {
+            stats.read_latency.record(latency);
+            stats.bytes += page_size;
+        } // TRIM은 데이터를 옮기지 않으므로 지연 시간 분포와 대역폭에서 뺌
+        fill(e.id, now);
+        if (pausing && outstanding == 0) {
+            // 호스트가 쉬는 동안 백그라운드 GC
+            Slot& bg = slots[background];
+            bg.next = 0;
+            bg.ops.clear();
+            ftl.set_nand_op_log(&bg.ops);
+            ftl.idle();
+            ftl.set_nand_op_log(nullptr);
+            events.push(now, background);
+            events.push(now + idle_gap, resume);
+        }
+    }
+
+    stats.elapsed += now;
+    stats.plane_busy += nand.busy_time();
+    return ok;
+}
+
+// 측정 결과 출력 (IOPS, 대역폭, 요청 종류별 지연 시간 분포)
+inline void print_timing_stats(const TimingStats& stats, const TimingConfig& cfg, std::ostream& out) {
+    double seconds = stats.elapsed / 1e9;
+    out << "--- Timing (" << cfg.channels << " ch x " << cfg.dies_per_channel << " die x "
+        << cfg.planes_per_die << " plane, QD " << cfg.queue_depth << ") ---" << std::endl;
+    out << std::fixed << std::setprecision(1);
+    if (seconds > 0) {
+        out << "IOPS:            " << stats.completed / seconds << std::endl;
+        out << "Bandwidth:       " << stats.bytes / seconds / (1024.0 * 1024.0) << " MB/s" << std::endl;
+        out << "Plane busy:      "
+            << 100.0 * stats.plane_busy / (static_cast<double>(stats.elapsed) * cfg.num_units()) << " %" << std::endl;
+    }
+    const LatencyHistogram* hists[] = {&stats.read_latency, &stats.write_latency};
+    const char* names[] = {"Read ", "Write"};
+    for (int k = 0; k < 2; ++k) {
+        const LatencyHistogram& h = *hists[k];
+        if (h.count() == 0) continue;
+        out << names[k] << " latency (us): n=" << h.count()
+            << " mean=" << h.mean() / 1000.0
+            << " p50=" << h.percentile(0.50) / 1000.0
+            << " p99=" << h.percentile(0.99) / 1000.0
+            << " p99.9=" << h.percentile(0.999) / 1000.0
+            << " max=" << h.max() / 1000.0 << std::endl;
+    }
+}
+
+#endif // TIMING_H
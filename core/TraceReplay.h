@@ -0,0 +1,365 @@
+#ifndef TRACE_REPLAY_H
+#define TRACE_REPLAY_H
+
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "Geometry.h"
+#include "Workload.h"
+#include "MappedFile.h"
+
+// 트레이스 형식
+// - MSR: MSR-Cambridge CSV  (Timestamp,Hostname,DiskNumber,Type,Offset,Size,ResponseTime, 오프셋/크기는 바이트)
+// - BLKPARSE: blkparse 기본 텍스트 출력 ("8,0 3 1 0.000000000 697 Q W 223490 + 8 [proc]", 섹터는 512바이트)
+//   (요청 하나가 여러 줄로 나오지 않도록 큐 진입(Q) 이벤트만 사용)
+// - BINARY: 8바이트 매직 "NANDTRC1" + 16바이트 고정 레코드 [offset u64][length u32][type u8][0 x3] (리틀 엔디언)
+//   (type: 0 = 읽기, 1 = 쓰기, 2 = discard)
+// - discard(TRIM)는 MSR의 Type이 D로 시작하거나 blkparse RWBS에 D가 있으면 인식
+enum class TraceFormat {
+    MSR,
+    BLKPARSE,
+    BINARY
+};
+
+inline bool parse_trace_format(const char* name, TraceFormat& format) {
+    if (std::strcmp(name, "msr") == 0) { format = TraceFormat::MSR; return true; }
+    if (std::strcmp(name, "blkparse") == 0) { format = TraceFormat::BLKPARSE; return true; }
+    if (std::strcmp(name, "bin") == 0) { format = TraceFormat::BINARY; return true; }
+    std::cerr << "Trace Error: unknown trace format '" << name << "' (msr | blkparse | bin)." << std::endl;
+    return false;
+}
+
+// 트레이스 요청 하나 (바이트 단위)
+struct TraceRecord {
+    OpType type;
+    uint64_t offset;
+    uint64_t length;
+};
+
+static const char BINARY_TRACE_MAGIC[8] = {'N', 'A', 'N', 'D', 'T', 'R', 'C', '1'};
+static const size_t BINARY_TRACE_RECORD_SIZE = 16;
+
+// 맵된 트레이스를 앞에서부터 한 레코드씩 해석하는 스트리밍 리더
+// - 줄을 std::string으로 복사하지 않고 맵된 버퍼 위에서 포인터만 움직이며 숫자를 바로 읽음
+// - 형식에 맞지 않는 줄(헤더, blkparse 요약, Q 이외의 이벤트 등)은 건너뛰고 skipped()로 셈
+class TraceReader {
+public:
+    TraceReader() : format_(TraceFormat::MSR), cur_(nullptr), end_(nullptr), skipped_(0) {}
+
+    bool open(const char* path, TraceFormat format) {
+        if (!file_.open(path)) {
+            std::cerr << "Trace Error: cannot open '" << path << "'." << std::endl;
+            return false;
+        }
+        format_ = format;
+        cur_ = file_.data();
+        end_ = cur_ + file_.size();
+        skipped_ = 0;
+        if (format_ == TraceFormat::BINARY) {
+            if (file_.size() < sizeof(BINARY_TRACE_MAGIC) ||
+                std::memcmp(cur_, BINARY_TRACE_MAGIC, sizeof(BINARY_TRACE_MAGIC)) != 0) {
+                std::cerr << "Trace Error: '" << path << "' is not a binary trace." << std::endl;
+                return false;
+            }
+            cur_ += sizeof(BINARY_TRACE_MAGIC);
+        }
+        return true;
+    }
+
+    // 다음 레코드를 읽음, 파일 끝이면 false
+    bool next(TraceRecord& rec) {
+        switch (format_) {
+        case TraceFormat::MSR: return next_msr(rec);
+        case TraceFormat::BLKPARSE: return next_blkparse(rec);
+        case TraceFormat::BINARY: return next_binary(rec);
+        }
+        return false;
+    }
+
+    long long skipped() const { return skipped_; }
+    size_t size_bytes() const { return file_.size(); }
+
+private:
+    // --- 포인터 기반 토큰 해석 도우미 ---
+    void skip_line() {
+        const char* nl = static_cast<const char*>(std::memchr(cur_, '\n', end_ - cur_));
+        cur_ = nl ? nl + 1 : end_;
+    }
+    void skip_spaces() {
+        while (cur_ < end_ && (*cur_ == ' ' || *cur_ == '\t')) ++cur_;
+    }
+    bool read_uint(uint64_t& value) {
+        if (cur_ >= end_ || *cur_ < '0' || *cur_ > '9') return false;
+        uint64_t v = 0;
+        while (cur_ < end_ && *cur_ >= '0' && *cur_ <= '9') v = v * 10 + static_cast<uint64_t>(*cur_++ - '0');
+        value = v;
+        return true;
+    }
+    // 구분자(sep)나 줄 끝까지의 토큰을 건너뛰고 [begin, end)를 돌려줌
+    void read_token(char sep, const char*& begin, const char*& tok_end) {
+        begin = cur_;
+        while (cur_ < end_ && *cur_ != sep && *cur_ != '\n' && *cur_ != '\r') ++cur_;
+        tok_end = cur_;
+    }
+
+    bool expect(char c) {
+        if (cur_ >= end_ || *cur_ != c) return false;
+        ++cur_;
+        return true;
+    }
+
+    bool next_msr(TraceRecord& rec) {
+        while (cur_ < end_) {
+            const char* b; const char* e;
+            // Timestamp, Hostname, DiskNumber, Type
+            bool ok = true;
+            for (int field = 0; field < 4 && ok; ++field) {
+                read_token(',', b, e);
+                ok = expect(',');
+            }
+            // Type 필드의 첫 글자로 읽기/쓰기/discard 판별 (Read / Write / Discard)
+            char kind = ok && b < e ? *b : 0;
+            uint64_t offset = 0, size = 0;
+            ok = ok && (kind == 'W' || kind == 'w' || kind == 'R' || kind == 'r' || kind == 'D' || kind == 'd') &&
+                 read_uint(offset) && expect(',') && read_uint(size);
+            if (cur_ < end_) skip_line();
+            if (ok) {
+                rec.type = (kind == 'W' || kind == 'w') ? OpType::WRITE
+                         : (kind == 'D' || kind == 'd') ? OpType::TRIM : OpType::READ;
+                rec.offset = offset;
+                rec.length = size;
+                return true;
+            }
+            skipped_++;
+        }
+        return false;
+    }
+
+    bool next_blkparse(TraceRecord& rec) {
+        while (cur_ < end_) {
+            const char* b; const char* e;
+            // dev(8,0) cpu seq time pid
+            bool ok = true;
+            for (int field = 0; field < 5 && ok; ++field) {
+                skip_spaces();
+                read_token(' ', b, e);
+                ok = b < e;
+            }
+            // action: 큐 진입(Q)만 사용
+            if (ok) {
+                skip_spaces();
+                read_token(' ', b, e);
+                ok = (e - b == 1 && *b == 'Q');
+            }
+            // RWBS
+            bool is_write = false, is_read = false, is_discard = false;
+            if (ok) {
+                skip_spaces();
+                read_token(' ', b, e);
+                for (const char* p = b; p < e; ++p) {
+                    if (*p == 'W') is_write = true;
+                    else if (*p == 'R') is_read = true;
+                    else if (*p == 'D') is_discard = true;
+                }
+                ok = is_write || is_read || is_discard;
+            }
+            uint64_t sector = 0, sectors = 0;
+            if (ok) {
+                skip_spaces();
+                ok = read_uint(sector);
+                skip_spaces();
+                ok = ok && expect('+');
+                skip_spaces();
+                ok = ok && read_uint(sectors);
+            }
+            if (cur_ < end_) skip_line();
+            if (ok) {
+                rec.type = is_discard ? OpType::TRIM : is_write ? OpType::WRITE : OpType::READ;
+                rec.offset = sector * 512;
+                rec.length = sectors * 512;
+                return true;
+            }
+            skipped_++;
+        }
+        return false;
+    }
+
+    bool next_binary(TraceRecord& rec) {
+        if (static_cast<size_t>(end_ - cur_) < BINARY_TRACE_RECORD_SIZE) return false;
+        uint64_t offset;
+        uint32_t length;
+        std::memcpy(&offset, cur_, sizeof(offset));      // 정렬되지 않은 주소일 수 있으므로 memcpy (레지스터 적재로 최적화됨)
+        std::memcpy(&length, cur_ + 8, sizeof(length));
+        rec.type = cur_[12] == 2 ? OpType::TRIM : cur_[12] ? OpType::WRITE : OpType::READ;
+        rec.offset = offset;
+        rec.length = length;
+        cur_ += BINARY_TRACE_RECORD_SIZE;
+        return true;
+    }
+
+    MappedFile file_;
+    TraceFormat format_;
+    const char* cur_;
+    const char* end_;
+    long long skipped_;
+};
+
+// 레코드를 이진 트레이스 형식으로 기록 (텍스트 트레이스를 한 번 변환해두면 다음부터 해석 비용 없이 재생)
+class BinaryTraceWriter {
+public:
+    BinaryTraceWriter() : fp_(nullptr) {}
+    ~BinaryTraceWriter() { close(); }
+
+    bool open(const char* path) {
+        fp_ = std::fopen(path, "wb");
+        if (!fp_) return false;
+        return std::fwrite(BINARY_TRACE_MAGIC, 1, sizeof(BINARY_TRACE_MAGIC), fp_) == sizeof(BINARY_TRACE_MAGIC);
+    }
+
+    void write(const TraceRecord& rec) {
+        char buf[BINARY_TRACE_RECORD_SIZE] = {0};
+        uint32_t length = static_cast<uint32_t>(rec.length);
+        std::memcpy(buf, &rec.offset, sizeof(rec.offset));
+        std::memcpy(buf + 8, &length, sizeof(length));
+        buf[12] = rec.type == OpType::TRIM ? 2 : rec.type == OpType::WRITE ? 1 : 0;
+        std::fwrite(buf, 1, sizeof(buf), fp_);
+    }
+
+    void close() {
+        if (fp_) std::fclose(fp_);
+        fp_ = nullptr;
+    }
+
+private:
+    FILE* fp_;
+};
+
+// 트레이스 재생 결과
+struct TraceStats {
+    long long records;       // 재생한 요청 수
+    long long skipped;       // 해석할 수 없어 건너뛴 줄 수
+    long long page_writes;   // FTL에 전달한 페이지 쓰기 수
+    long long page_reads;    // FTL에 전달한 페이지 읽기 수
+    long long page_trims;    // FTL에 전달한 페이지 TRIM 수
+    bool failed;             // FTL 쓰기 실패로 중단됨
+
+    TraceStats() : records(0), skipped(0), page_writes(0), page_reads(0), page_trims(0), failed(false) {}
+};
+
+// 트레이스를 FTL에 흘려보냄
+// - 요청 [offset, offset + length)가 걸치는 모든 논리 페이지를 page_size 단위로 계산해 페이지마다 read/write 호출
+// - 트레이스가 시뮬레이션 장치보다 크면 LPN을 논리 페이지 수로 나눈 나머지로 접음
+// - writer가 있으면 재생하면서 이진 트레이스로도 기록
+template <typename FtlT>
+TraceStats replay_trace(TraceReader& reader, FtlT& ftl, int page_size, int64_t num_lpns,
+                        BinaryTraceWriter* writer = nullptr) {
+    TraceStats stats;
+    TraceRecord rec;
+    while (reader.next(rec)) {
+        stats.records++;
+        if (writer) writer->write(rec);
+        if (rec.length == 0) continue;
+        uint64_t first = rec.offset / page_size;
+        uint64_t last = (rec.offset + rec.length - 1) / page_size;
+        Lpn lpn = static_cast<Lpn>(first % num_lpns);
+        if (rec.type == OpType::TRIM) {
+            // discard는 접힌 LPN 구간이 끝에 닿을 때마다 나눠서 한 번씩 전달
+            // (일부만 걸친 페이지도 통째로 TRIM, 파일시스템은 보통 페이지 단위로 discard함)
+            uint64_t left = last - first + 1;
+            while (left > 0) {
+                uint64_t run = static_cast<uint64_t>(num_lpns - lpn) < left ? static_cast<uint64_t>(num_lpns - lpn) : left;
+                if (run > INT32_MAX) run = INT32_MAX;
+                if (!ftl.trim(lpn, static_cast<int>(run))) {
+                    stats.failed = true;
+                    stats.skipped = reader.skipped();
+                    return stats;
+                }
+                stats.page_trims += run;
+                left -= run;
+                lpn = (lpn + static_cast<Lpn>(run)) % num_lpns;
+            }
+            continue;
+        }
+        for (uint64_t p = first; p <= last; ++p) {
+            if (rec.type == OpType::WRITE) {
+                if (!ftl.write(lpn)) {
+                    stats.failed = true;
+                    stats.skipped = reader.skipped();
+                    return stats;
+                }
+                stats.page_writes++;
+            } else {
+                ftl.read(lpn);
+                stats.page_reads++;
+            }
+            if (++lpn == num_lpns) lpn = 0;
+        }
+    }
+    stats.skipped = reader.skipped();
+    return stats;
+}
+
+// 트레이스 재생 설정
+//   --trace PATH  --trace-format msr|blkparse|bin  --trace-out PATH(이진 변환본 저장)
+struct TraceOptions {
+    std::string path;
+    TraceFormat format;
+    std::string out_path;
+
+    TraceOptions() : format(TraceFormat::MSR) {}
+    bool enabled() const { return !path.empty(); }
+};
+
+inline bool parse_trace_args(int argc, char** argv, TraceOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--trace") == 0) {
+            opt.path = argv[i + 1]; ++i;
+        } else if (std::strcmp(argv[i], "--trace-format") == 0) {
+            if (!parse_trace_format(argv[i + 1], opt.format)) return false;
+            ++i;
+        } else if (std::strcmp(argv[i], "--trace-out") == 0) {
+            opt.out_path = argv[i + 1]; ++i;
+        }
+    }
+    return true;
+}
+
+// 트레이스 한 개를 FTL 하나에 재생하고 결과를 출력 (드라이버의 --trace 모드, 반환값은 종료 코드)
+// (params는 FtlT 생성자에 그대로 넘김)
+template <typename FtlT, typename Params>
+int run_trace_replay(const TraceOptions& opt, const Geometry& geo, const Params& params) {
+    TraceReader reader;
+    if (!reader.open(opt.path.c_str(), opt.format)) return 1;
+    BinaryTraceWriter writer;
+    if (!opt.out_path.empty() && !writer.open(opt.out_path.c_str())) {
+        std::cerr << "Trace Error: cannot create '" << opt.out_path << "'." << std::endl;
+        return 1;
+    }
+
+    FtlT ftl(geo, params);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    TraceStats stats = replay_trace(reader, ftl, geo.page_size, geo.logical_pages(),
+                                    opt.out_path.empty() ? nullptr : &writer);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Trace: " << opt.path << " (" << reader.size_bytes() << " bytes)" << std::endl;
+    std::cout << "Records: " << stats.records << " (skipped lines: " << stats.skipped << ")" << std::endl;
+    std::cout << "Page writes: " << stats.page_writes << ", page reads: " << stats.page_reads
+              << ", page trims: " << stats.page_trims << std::endl;
+    std::cout << std::fixed << std::setprecision(5);
+    std::cout << "WAF: " << ftl.getWAF() << std::endl;
+    std::cout << std::setprecision(2) << "Replay time: " << seconds << " s ("
+              << reader.size_bytes() / (seconds > 0 ? seconds : 1e-9) / (1024 * 1024) << " MB/s)" << std::endl;
+    if (stats.failed) {
+        std::cout << "--- Replay stopped due to a fatal FTL error ---" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+#endif // TRACE_REPLAY_H
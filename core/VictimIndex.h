@@ -0,0 +1,206 @@
+#ifndef VICTIM_INDEX_H
+#define VICTIM_INDEX_H
+
+#include <vector>
+#include "Snapshot.h"
+
+// GC 희생양(Victim) 후보 인덱스
+// - 꽉 차서 닫힌(sealed) 블록들을 "invalid 페이지 수"별 버킷(0 ~ pages_per_block)에 보관
+// - 각 버킷은 배열로 구현한 침입형(intrusive) 이중 연결 리스트라서 삽입/삭제/버킷 이동이 O(1)
+// - 가장 큰 비어있지 않은 버킷을 가리키는 커서(max_bucket_)를 유지하므로 Greedy 선택이 O(1) (분할 상환)
+// - 블록이 닫힌 순서대로 연결한 별도 리스트도 유지해서 "가장 오래된 블록" 선택도 O(1)
+// - 버킷 안에서는 마지막으로 무효화된 시점 순서(앞쪽일수록 오래됨)로 정렬됨
+//   -> 버킷 머리만 보면 "같은 invalid 수 중 가장 오래 안 바뀐 블록"이므로 나이 기반 정책도 버킷 수만큼만 보면 됨
+// - 후보 전체를 조밀한 배열(members_)로도 유지해서 무작위 표본 추출(d-choices)이 O(1)
+class VictimIndex {
+public:
+    VictimIndex(int num_blocks, int pages_per_block)
+        : bucket_of_(num_blocks, NONE), next_(num_blocks, NONE), prev_(num_blocks, NONE),
+          age_next_(num_blocks, NONE), age_prev_(num_blocks, NONE), slot_(num_blocks, NONE),
+          head_(pages_per_block + 1, NONE), tail_(pages_per_block + 1, NONE),
+          age_head_(NONE), age_tail_(NONE), max_bucket_(NONE), size_(0) {
+        members_.reserve(num_blocks);
+    }
+
+    bool contains(int block) const { return bucket_of_[block] != NONE; }
+    int invalid_of(int block) const { return bucket_of_[block]; } // 후보가 아니면 -1
+    int size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // 닫힌 블록을 후보로 등록 (invalid_pages: 등록 시점의 invalid 페이지 수)
+    void insert(int block, int invalid_pages) {
+        if (contains(block)) return;
+        link_bucket(block, invalid_pages);
+        age_prev_[block] = age_tail_;
+        age_next_[block] = NONE;
+        if (age_tail_ != NONE) age_next_[age_tail_] = block; else age_head_ = block;
+        age_tail_ = block;
+        slot_[block] = static_cast<int>(members_.size());
+        members_.push_back(block);
+        size_++;
+    }
+
+    void remove(int block) {
+        if (!contains(block)) return;
+        unlink_bucket(block);
+        if (age_prev_[block] != NONE) age_next_[age_prev_[block]] = age_next_[block]; else age_head_ = age_next_[block];
+        if (age_next_[block] != NONE) age_prev_[age_next_[block]] = age_prev_[block]; else age_tail_ = age_prev_[block];
+        age_prev_[block] = age_next_[block] = NONE;
+        // 조밀 배열에서는 마지막 원소를 빈 자리로 옮겨서 O(1) 삭제
+        int last = members_.back();
+        members_[slot_[block]] = last;
+        slot_[last] = slot_[block];
+        members_.pop_back();
+        slot_[block] = NONE;
+        size_--;
+    }
+
+    // 후보 블록의 페이지 하나가 무효화됨 -> 한 칸 위 버킷으로 이동 (후보가 아니면 무시)
+    void on_invalidate(int block) {
+        if (!contains(block)) return;
+        int bucket = bucket_of_[block];
+        unlink_bucket(block);
+        link_bucket(block, bucket + 1);
+    }
+
+    // 가장 invalid 페이지가 많은 후보의 invalid 페이지 수 (후보가 없으면 -1)
+    int max_invalid() {
+        settle_max();
+        return max_bucket_;
+    }
+
+    // invalid 페이지가 가장 많은 후보를 꺼냄 (같으면 가장 오래전에 무효화된 블록), 없으면 -1
+    int pop_max() {
+        settle_max();
+        if (max_bucket_ == NONE) return -1;
+        int block = head_[max_bucket_];
+        remove(block);
+        return block;
+    }
+
+    // 가장 먼저 닫힌 후보 (꺼내지 않음), 없으면 -1
+    int peek_oldest() const { return age_head_; }
+
+    // 가장 먼저 닫힌 후보를 꺼냄, 없으면 -1
+    int pop_oldest() {
+        int block = age_head_;
+        if (block != NONE) remove(block);
+        return block;
+    }
+
+    // --- 순회/표본 추출 (꺼내지 않고 보기만 함, 고른 블록은 remove로 꺼냄) ---
+
+    // invalid 페이지 수가 bucket인 후보 중 가장 오래전에 무효화된 블록, 없으면 -1
+    int bucket_head(int bucket) const { return head_[bucket]; }
+    int num_buckets() const { return static_cast<int>(head_.size()); }
+    // 닫힌 순서 리스트에서 block 다음(더 최근에 닫힌) 후보, 없으면 -1
+    int age_next(int block) const { return age_next_[block]; }
+    // 후보 i번째 (0 <= i < size(), 순서는 삽입/삭제에 따라 바뀜)
+    int member(int i) const { return members_[i]; }
+
+    // 인덱스가 차지하는 메모리 (블록별 링크 5개 + 조밀 배열/위치 2개 + 버킷별 머리/꼬리)
+    static long long bytes_for(int num_blocks, int pages_per_block) {
+        return (7LL * num_blocks + 2LL * (pages_per_block + 1)) * static_cast<long long>(sizeof(int));
+    }
+    long long metadata_bytes() const {
+        return bytes_for(static_cast<int>(bucket_of_.size()), static_cast<int>(head_.size()) - 1);
+    }
+
+    // 스냅샷: 링크 배열을 그대로 저장 (버킷 안 순서, 닫힌 순서, 표본 추출용 배열 순서까지 같게 복원)
+    void save(SnapshotWriter& w) const {
+        w.put(bucket_of_);
+        w.put(next_);
+        w.put(prev_);
+        w.put(age_next_);
+        w.put(age_prev_);
+        w.put(slot_);
+        w.put(head_);
+        w.put(tail_);
+        w.put(members_);
+        w.put_value(age_head_);
+        w.put_value(age_tail_);
+        w.put_value(max_bucket_);
+    }
+    bool load(SnapshotCursor& c) {
+        c.get_exact(bucket_of_);
+        c.get_exact(next_);
+        c.get_exact(prev_);
+        c.get_exact(age_next_);
+        c.get_exact(age_prev_);
+        c.get_exact(slot_);
+        c.get_exact(head_);
+        c.get_exact(tail_);
+        c.get(members_);
+        age_head_ = static_cast<int>(c.value());
+        age_tail_ = static_cast<int>(c.value());
+        max_bucket_ = static_cast<int>(c.value());
+        size_ = static_cast<int>(members_.size());
+        return c.ok() && members_.size() <= bucket_of_.size() && links_in_range();
+    }
+
+    // 전체 후보를 비움
+    void clear() {
+        while (age_head_ != NONE) remove(age_head_);
+        max_bucket_ = NONE;
+    }
+
+private:
+    static constexpr int NONE = -1;
+
+    void link_bucket(int block, int bucket) {
+        bucket_of_[block] = bucket;
+        prev_[block] = tail_[bucket];
+        next_[block] = NONE;
+        if (tail_[bucket] != NONE) next_[tail_[bucket]] = block; else head_[bucket] = block;
+        tail_[bucket] = block;
+        if (bucket > max_bucket_) max_bucket_ = bucket;
+    }
+
+    void unlink_bucket(int block) {
+        int bucket = bucket_of_[block];
+        if (prev_[block] != NONE) next_[prev_[block]] = next_[block]; else head_[bucket] = next_[block];
+        if (next_[block] != NONE) prev_[next_[block]] = prev_[block]; else tail_[bucket] = prev_[block];
+        prev_[block] = next_[block] = NONE;
+        bucket_of_[block] = NONE;
+    }
+
+    // 불러온 링크가 모두 범위 안인지 (블록 번호는 NONE 또는 [0, 블록 수), 버킷 번호는 NONE 또는 [0, 버킷 수))
+    // 조밀 배열의 후보는 slot_과 서로 가리켜야 함 (손상된 스냅샷이 배열 밖을 가리키지 않도록)
+    bool links_in_range() const {
+        const int blocks = static_cast<int>(bucket_of_.size());
+        const int buckets = static_cast<int>(head_.size());
+        auto block_ok = [blocks](int b) { return b == NONE || (b >= 0 && b < blocks); };
+        auto bucket_ok = [buckets](int b) { return b == NONE || (b >= 0 && b < buckets); };
+        for (int b = 0; b < blocks; ++b) {
+            if (!bucket_ok(bucket_of_[b]) || !block_ok(next_[b]) || !block_ok(prev_[b]) || !block_ok(age_next_[b]) ||
+                !block_ok(age_prev_[b]) || !(slot_[b] == NONE || (slot_[b] >= 0 && slot_[b] < size_))) {
+                return false;
+            }
+        }
+        for (int k = 0; k < buckets; ++k) {
+            if (!block_ok(head_[k]) || !block_ok(tail_[k])) return false;
+        }
+        for (int i = 0; i < size_; ++i) {
+            const int b = members_[i];
+            if (b < 0 || b >= blocks || bucket_of_[b] == NONE || slot_[b] != i) return false;
+        }
+        return block_ok(age_head_) && block_ok(age_tail_) && bucket_ok(max_bucket_);
+    }
+
+    // 비어버린 버킷은 커서를 내리면서 건너뜀 (커서는 올라갈 때 1칸씩만 오르므로 분할 상환 O(1))
+    void settle_max() {
+        while (max_bucket_ != NONE && head_[max_bucket_] == NONE) max_bucket_--;
+    }
+
+    std::vector<int> bucket_of_; // 블록이 속한 버킷 (= invalid 페이지 수), 후보가 아니면 NONE
+    std::vector<int> next_, prev_;         // 버킷 리스트 링크
+    std::vector<int> age_next_, age_prev_; // 닫힌 순서 리스트 링크
+    std::vector<int> slot_;                // 블록의 members_ 안 위치
+    std::vector<int> members_;             // 후보 블록 조밀 배열 (무작위 표본용)
+    std::vector<int> head_, tail_;         // 버킷별 리스트의 머리/꼬리
+    int age_head_, age_tail_;
+    int max_bucket_;
+    int size_;
+};
+
+#endif // VICTIM_INDEX_H
@@ -0,0 +1,102 @@
+#ifndef WEAR_LEVELING_H
+#define WEAR_LEVELING_H
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "NandFlash.h"
+
+// 웨어 레벨링 설정과 지우기 횟수 분포
+// - 동적 웨어 레벨링: 빈 블록을 지우기 횟수가 적은 것부터 꺼냄 (AllocPolicy::MIN_ERASE, FreeBlockPool.h)
+//   -> 새로 쓰는 데이터(대개 뜨거움)가 덜 닳은 블록으로 감
+// - 정적 웨어 레벨링: 차가운 데이터가 앉아 있는 블록은 GC 희생양이 되지 않아 계속 덜 닳음.
+//   가장 많이 지운 블록과 데이터가 든 블록 중 가장 적게 지운 블록의 차이가 threshold를 넘으면
+//   그 블록의 유효 페이지를 옮기고 지워서 빈 블록 풀로 돌려보냄 (check_erases번 지울 때마다 검사)
+// - 옮긴 페이지도 NAND 쓰기이므로 WAF에 그대로 들어감
+
+struct WearOptions {
+    AllocPolicy alloc;      // 빈 블록 할당 순서
+    int static_threshold;   // 정적 웨어 레벨링을 시작하는 지우기 횟수 차이 (0이면 끔)
+    long long check_erases; // 정적 웨어 레벨링 검사 주기 (지우기 횟수, 0이면 블록 수)
+
+    WearOptions() : alloc(AllocPolicy::FIFO), static_threshold(0), check_erases(0) {}
+
+    bool static_enabled() const { return static_threshold > 0; }
+};
+
+inline const char* alloc_policy_name(AllocPolicy policy) {
+    return policy == AllocPolicy::MIN_ERASE ? "min-erase" : "fifo";
+}
+
+// 명령행 인자에서 웨어 레벨링 설정을 읽음 (모르는 인자는 건너뜀)
+//   --alloc fifo|min-erase  --wl-threshold N  --wl-check N
+inline bool parse_wear_args(int argc, char** argv, WearOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--alloc") == 0) {
+            std::string alloc = value;
+            if (alloc == "fifo") opt.alloc = AllocPolicy::FIFO;
+            else if (alloc == "min-erase") opt.alloc = AllocPolicy::MIN_ERASE;
+            else {
+                std::cerr << "Wear Error: unknown allocation policy '" << alloc << "' (fifo | min-erase)." << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (std::strcmp(key, "--wl-threshold") == 0) {
+            opt.static_threshold = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--wl-check") == 0) {
+            opt.check_erases = std::strtoll(value, nullptr, 10); ++i;
+        }
+    }
+    if (opt.static_threshold < 0 || opt.check_erases < 0) {
+        std::cerr << "Wear Error: --wl-threshold and --wl-check must not be negative." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 블록별 지우기 횟수를 히스토그램에 더함 (hist[c] = 지우기 횟수가 c인 블록 수)
+inline void add_erase_histogram(const NandFlash& nand, std::vector<long long>& hist) {
+    for (int b = 0; b < nand.num_blocks(); ++b) {
+        size_t c = static_cast<size_t>(nand.erase_count(b));
+        if (c >= hist.size()) hist.resize(c + 1, 0);
+        hist[c]++;
+    }
+}
+
+// 지우기 횟수 분포 요약 (히스토그램에서 계산)
+struct EraseCountSummary {
+    int min, max;
+    double mean, stddev;
+
+    EraseCountSummary() : min(0), max(0), mean(0.0), stddev(0.0) {}
+};
+
+inline EraseCountSummary summarize_erase_counts(const std::vector<long long>& hist) {
+    EraseCountSummary s;
+    long long n = 0;
+    double sum = 0.0, sum_sq = 0.0;
+    s.min = -1;
+    for (size_t c = 0; c < hist.size(); ++c) {
+        if (hist[c] == 0) continue;
+        if (s.min == -1) s.min = static_cast<int>(c);
+        s.max = static_cast<int>(c);
+        n += hist[c];
+        sum += static_cast<double>(c) * hist[c];
+        sum_sq += static_cast<double>(c) * c * hist[c];
+    }
+    if (n == 0) {
+        s.min = 0;
+        return s;
+    }
+    s.mean = sum / n;
+    double var = sum_sq / n - s.mean * s.mean;
+    s.stddev = var > 0 ? std::sqrt(var) : 0.0;
+    return s;
+}
+
+#endif // WEAR_LEVELING_H
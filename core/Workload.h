@@ -0,0 +1,404 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Geometry.h"
+#include "Rng.h"
+
+// 호스트 요청 종류
+enum class OpType {
+    READ,
+    WRITE,
+    TRIM    // discard: [lpn, lpn + count) 구간의 데이터가 더 이상 필요 없음
+};
+
+struct Op {
+    OpType type;
+    int stream; // 호스트 스트림 힌트 (쓰기만, 힌트를 끄면 -1)
+    Lpn lpn;
+    int count;  // TRIM만: 연속한 논리 페이지 수
+};
+
+// 워크로드 생성기 공통 인터페이스
+// - next()로 요청을 하나씩 꺼내지만, 실제 생성은 BATCH개씩 내부 버퍼에 몰아서 함
+//   (가상 함수 호출은 배치당 한 번, 배치 안의 루프는 각 생성기에 인라인됨)
+// - 쓰기 비율(write_ratio)만큼 쓰기, trim_ratio만큼 TRIM, 나머지는 전체 LPN 구간에 균등한 읽기
+//   (TRIM은 파일 삭제처럼 생성기가 다음에 쓸 위치에서 시작하는 1 ~ trim_pages개 페이지 구간,
+//    trim_ratio가 0이면 난수를 더 쓰지 않으므로 요청열은 TRIM이 없던 때와 같음)
+// - 난수는 생성기가 가진 Rng 하나만 사용하므로 같은 Rng로 만들면 항상 같은 요청열
+// - set_host_streams(n)을 켜면 호스트가 아는 온도(각 생성기의 heat, 0 = 가장 차가움 ~ 1 = 가장 뜨거움)를
+//   n개 구간으로 나눠 쓰기마다 스트림 힌트로 붙임 (난수를 쓰지 않으므로 요청열은 그대로)
+class Workload {
+public:
+    static const size_t BATCH = 4096;
+
+    Workload(int64_t num_lpns, double write_ratio, const Rng& rng)
+        : num_lpns_(num_lpns), write_ratio_(write_ratio), trim_ratio_(0.0), trim_pages_(1), rng_(rng),
+          host_streams_(0), buf_(BATCH), pos_(0), filled_(0) {}
+    virtual ~Workload() {}
+
+    const Op& next() {
+        if (pos_ == filled_) {
+            generate(buf_.data(), BATCH);
+            pos_ = 0;
+            filled_ = BATCH;
+        }
+        return buf_[pos_++];
+    }
+
+    // 요청 n개를 out에 바로 채움 (내부 버퍼를 거치지 않음)
+    void fill(Op* out, size_t n) { generate(out, n); }
+
+    virtual const char* name() const = 0;
+
+    int64_t num_lpns() const { return num_lpns_; }
+
+    void set_host_streams(int n) { host_streams_ = n; }
+    void set_trim(double ratio, int max_pages) {
+        trim_ratio_ = ratio;
+        trim_pages_ = max_pages;
+    }
+
+protected:
+    virtual void generate(Op* out, size_t n) = 0;
+
+    int64_t num_lpns_;
+    double write_ratio_;
+    double trim_ratio_;
+    int trim_pages_;
+    Rng rng_;
+    int host_streams_; // 0이면 스트림 힌트 없음
+
+private:
+    std::vector<Op> buf_;
+    size_t pos_, filled_;
+};
+
+// 배치 생성 루프를 한 번만 작성하기 위한 CRTP 베이스
+// (Derived는 Lpn write_lpn()과 double heat(Lpn) 두 개만 구현하면 됨, 정적 호출이라 인라인됨)
+template <typename Derived>
+class WorkloadBase : public Workload {
+public:
+    WorkloadBase(int64_t num_lpns, double write_ratio, const Rng& rng) : Workload(num_lpns, write_ratio, rng) {}
+
+protected:
+    void generate(Op* out, size_t n) override {
+        Derived& self = static_cast<Derived&>(*this);
+        for (size_t i = 0; i < n; ++i) {
+            double u = rng_.uniform();
+            if (u < write_ratio_) {
+                out[i].type = OpType::WRITE;
+                out[i].lpn = self.write_lpn();
+                out[i].stream = -1;
+                out[i].count = 1;
+                if (host_streams_ > 0) {
+                    int hint = static_cast<int>(self.heat(out[i].lpn) * host_streams_);
+                    out[i].stream = hint < host_streams_ ? hint : host_streams_ - 1;
+                }
+            } else if (u < write_ratio_ + trim_ratio_) {
+                out[i].type = OpType::TRIM;
+                out[i].stream = -1;
+                out[i].lpn = self.write_lpn();
+                int64_t left = num_lpns_ - out[i].lpn;
+                int count = 1 + static_cast<int>(rng_.below(trim_pages_));
+                out[i].count = count < left ? count : static_cast<int>(left);
+            } else {
+                out[i].type = OpType::READ;
+                out[i].stream = -1;
+                out[i].count = 1;
+                out[i].lpn = static_cast<Lpn>(rng_.below(num_lpns_));
+            }
+        }
+    }
+};
+
+// 모든 LPN에 균등하게 쓰기
+class UniformWorkload : public WorkloadBase<UniformWorkload> {
+public:
+    UniformWorkload(int64_t num_lpns, double write_ratio, const Rng& rng)
+        : WorkloadBase(num_lpns, write_ratio, rng) {}
+
+    const char* name() const override { return "Uniform"; }
+    Lpn write_lpn() { return static_cast<Lpn>(rng_.below(num_lpns_)); }
+    double heat(Lpn) const { return 0.0; }
+};
+
+// 앞쪽 hot_fraction 만큼의 LPN(Hot Zone)에 쓰기의 hot_access 비율이 몰림 (예: 90/10)
+class HotColdWorkload : public WorkloadBase<HotColdWorkload> {
+public:
+    HotColdWorkload(int64_t num_lpns, double write_ratio, const Rng& rng, double hot_fraction, double hot_access)
+        : WorkloadBase(num_lpns, write_ratio, rng), hot_access_(hot_access),
+          hot_lpns_(static_cast<int64_t>(num_lpns * hot_fraction)), cold_lpns_(num_lpns - hot_lpns_) {}
+
+    const char* name() const override { return "Hot/Cold"; }
+    Lpn write_lpn() {
+        if (rng_.uniform() < hot_access_) return static_cast<Lpn>(rng_.below(hot_lpns_));
+        return hot_lpns_ + static_cast<Lpn>(rng_.below(cold_lpns_));
+    }
+    double heat(Lpn lpn) const { return lpn < hot_lpns_ ? 1.0 : 0.0; }
+
+private:
+    double hot_access_;
+    int64_t hot_lpns_, cold_lpns_;
+};
+
+// Zipf 분포 (LPN k의 쓰기 확률 ∝ 1 / (k+1)^theta)
+// - 거절-역변환(rejection-inversion, Hörmann & Derflinger) 방식이라 테이블 없이 O(1) 메모리/시간
+//   -> 수억 개 LPN에서도 별칭(alias) 테이블처럼 LPN당 메모리를 쓰지 않음
+class ZipfWorkload : public WorkloadBase<ZipfWorkload> {
+public:
+    ZipfWorkload(int64_t num_lpns, double write_ratio, const Rng& rng, double theta)
+        : WorkloadBase(num_lpns, write_ratio, rng), theta_(theta) {
+        h_integral_x1_ = h_integral(1.5) - 1.0;
+        h_integral_n_ = h_integral(num_lpns + 0.5);
+        s_ = 2.0 - h_integral_inverse(h_integral(2.5) - h(2.0));
+    }
+
+    const char* name() const override { return "Zipf"; }
+    Lpn write_lpn() {
+        while (true) {
+            double u = h_integral_n_ + rng_.uniform() * (h_integral_x1_ - h_integral_n_);
+            double x = h_integral_inverse(u);
+            int64_t k = static_cast<int64_t>(x + 0.5);
+            if (k < 1) k = 1;
+            else if (k > num_lpns_) k = num_lpns_;
+            if (k - x <= s_ || u >= h_integral(k + 0.5) - h(static_cast<double>(k))) {
+                return static_cast<Lpn>(k - 1);
+            }
+        }
+    }
+    // 순위를 로그 눈금으로 (LPN 0이 1, 마지막 LPN이 0)
+    double heat(Lpn lpn) const { return 1.0 - std::log(lpn + 1.0) / std::log(num_lpns_ + 1.0); }
+
+private:
+    double h(double x) const { return std::exp(-theta_ * std::log(x)); }
+    double h_integral(double x) const {
+        double log_x = std::log(x);
+        return helper2((1.0 - theta_) * log_x) * log_x;
+    }
+    double h_integral_inverse(double x) const {
+        double t = x * (1.0 - theta_);
+        if (t < -1.0) t = -1.0;
+        return std::exp(helper1(t) * x);
+    }
+    // log1p(x)/x 와 expm1(x)/x (x가 0 근처일 때는 테일러 전개)
+    static double helper1(double x) {
+        return std::fabs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+    static double helper2(double x) {
+        return std::fabs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+    }
+
+    double theta_;
+    double h_integral_x1_, h_integral_n_, s_;
+};
+
+// Hot Zone / Cold Zone을 50:50으로 골라 그 구역에 연속으로 몰아 쓰는 버스트 쓰기
+// (버스트 길이는 [min_burst, max_burst] 에서 균등)
+class BurstyWorkload : public WorkloadBase<BurstyWorkload> {
+public:
+    BurstyWorkload(int64_t num_lpns, double write_ratio, const Rng& rng, double hot_fraction,
+                   int min_burst, int max_burst)
+        : WorkloadBase(num_lpns, write_ratio, rng),
+          hot_lpns_(static_cast<int64_t>(num_lpns * hot_fraction)), cold_lpns_(num_lpns - hot_lpns_),
+          min_burst_(min_burst), burst_span_(max_burst - min_burst + 1),
+          currently_hot_(true), remaining_(0) {}
+
+    const char* name() const override { return "Bursty"; }
+    Lpn write_lpn() {
+        if (remaining_ == 0) {
+            currently_hot_ = rng_.below(2) == 0;
+            remaining_ = min_burst_ + static_cast<int>(rng_.below(burst_span_));
+        }
+        remaining_--;
+        if (currently_hot_) return static_cast<Lpn>(rng_.below(hot_lpns_));
+        return hot_lpns_ + static_cast<Lpn>(rng_.below(cold_lpns_));
+    }
+    double heat(Lpn lpn) const { return lpn < hot_lpns_ ? 1.0 : 0.0; }
+
+private:
+    int64_t hot_lpns_, cold_lpns_;
+    int min_burst_, burst_span_;
+    bool currently_hot_;
+    int remaining_;
+};
+
+// 여러 개의 순차 쓰기 스트림이 섞여 들어옴
+// - 스트림 i는 LPN 공간을 num_streams 등분한 구간의 시작에서 출발해 한 페이지씩 전진 (끝에 닿으면 0으로 돌아감)
+// - 쓰기마다 스트림 하나를 균등하게 골라 그 스트림의 다음 LPN을 씀
+class SequentialWorkload : public WorkloadBase<SequentialWorkload> {
+public:
+    SequentialWorkload(int64_t num_lpns, double write_ratio, const Rng& rng, int num_streams)
+        : WorkloadBase(num_lpns, write_ratio, rng), cursor_(num_streams) {
+        for (int i = 0; i < num_streams; ++i) cursor_[i] = num_lpns / num_streams * i;
+    }
+
+    const char* name() const override { return "Sequential"; }
+    Lpn write_lpn() {
+        int64_t& cur = cursor_[rng_.below(cursor_.size())];
+        Lpn lpn = cur;
+        if (++cur == num_lpns_) cur = 0;
+        return lpn;
+    }
+    // 온도는 모두 같으므로 LPN 구간(= 처음 출발한 순차 스트림) 번호를 힌트로 씀
+    double heat(Lpn lpn) const {
+        return static_cast<double>(lpn) / num_lpns_;
+    }
+
+private:
+    std::vector<int64_t> cursor_;
+};
+
+// 시간에 따라 Hot Zone이 옮겨가는 워크로드
+// - Hot/Cold와 같은 분포지만, 쓰기 phase_writes번마다 Hot Zone 시작점이 Hot Zone 크기만큼 뒤로 이동 (끝에서 다시 앞으로)
+// - 예전 Hot 데이터가 Cold로 식어가는 상황을 만들어 온도 분류의 적응 속도를 확인하는 용도
+class PhaseShiftWorkload : public WorkloadBase<PhaseShiftWorkload> {
+public:
+    PhaseShiftWorkload(int64_t num_lpns, double write_ratio, const Rng& rng, double hot_fraction,
+                       double hot_access, int64_t phase_writes)
+        : WorkloadBase(num_lpns, write_ratio, rng), hot_access_(hot_access),
+          hot_lpns_(static_cast<int64_t>(num_lpns * hot_fraction)), cold_lpns_(num_lpns - hot_lpns_),
+          phase_writes_(phase_writes), writes_in_phase_(0), hot_start_(0) {}
+
+    const char* name() const override { return "Phase-shifting Hot/Cold"; }
+    Lpn write_lpn() {
+        if (++writes_in_phase_ > phase_writes_) {
+            writes_in_phase_ = 1;
+            hot_start_ += hot_lpns_;
+            if (hot_start_ >= num_lpns_) hot_start_ -= num_lpns_;
+        }
+        int64_t offset = rng_.uniform() < hot_access_ ? static_cast<int64_t>(rng_.below(hot_lpns_))
+                                                      : hot_lpns_ + static_cast<int64_t>(rng_.below(cold_lpns_));
+        int64_t lpn = hot_start_ + offset;
+        return lpn >= num_lpns_ ? lpn - num_lpns_ : lpn;
+    }
+    // 호스트는 지금 Hot Zone이 어디인지 앎
+    double heat(Lpn lpn) const {
+        int64_t offset = lpn - hot_start_;
+        if (offset < 0) offset += num_lpns_;
+        return offset < hot_lpns_ ? 1.0 : 0.0;
+    }
+
+private:
+    double hot_access_;
+    int64_t hot_lpns_, cold_lpns_;
+    int64_t phase_writes_, writes_in_phase_;
+    int64_t hot_start_;
+};
+
+// 워크로드 종류와 매개변수 (기본값은 기존 90/10 실험과 동일)
+struct WorkloadOptions {
+    std::string kind;       // uniform | hotcold | zipf | bursty | sequential | phase
+    double write_ratio;     // 전체 요청 중 쓰기 비율
+    double hot_fraction;    // Hot Zone이 차지하는 LPN 비율
+    double hot_access;      // 쓰기 중 Hot Zone으로 가는 비율
+    double zipf_theta;      // Zipf 지수
+    int min_burst, max_burst;
+    int streams;            // 순차 스트림 개수
+    int64_t phase_writes;   // Hot Zone이 이동하는 주기 (쓰기 횟수)
+    int host_streams;       // 쓰기에 붙일 스트림 힌트 개수 (0이면 힌트 없음)
+    double trim_ratio;      // 요청 중 TRIM 비율 (0이면 TRIM 없음)
+    int trim_pages;         // TRIM 한 번의 최대 페이지 수
+
+    WorkloadOptions()
+        : kind("hotcold"), write_ratio(0.8), hot_fraction(0.1), hot_access(0.9), zipf_theta(0.99),
+          min_burst(25), max_burst(34), streams(4), phase_writes(10000), host_streams(0),
+          trim_ratio(0.0), trim_pages(16) {}
+};
+
+// 명령행 인자에서 워크로드 설정을 읽음 (모르는 인자는 건너뜀, 알 수 없는 종류거나 값이 범위를 벗어나면 false)
+//   --workload KIND  --write-ratio R  --hot-fraction F  --hot-access A  --zipf-theta T
+//   --burst-min N  --burst-max N  --streams N  --phase-writes N  --trim-ratio R  --trim-pages N
+inline bool parse_workload_args(int argc, char** argv, WorkloadOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--workload") == 0) {
+            opt.kind = value; ++i;
+        } else if (std::strcmp(key, "--write-ratio") == 0) {
+            opt.write_ratio = std::atof(value); ++i;
+        } else if (std::strcmp(key, "--hot-fraction") == 0) {
+            opt.hot_fraction = std::atof(value); ++i;
+        } else if (std::strcmp(key, "--hot-access") == 0) {
+            opt.hot_access = std::atof(value); ++i;
+        } else if (std::strcmp(key, "--zipf-theta") == 0) {
+            opt.zipf_theta = std::atof(value); ++i;
+        } else if (std::strcmp(key, "--burst-min") == 0) {
+            opt.min_burst = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--burst-max") == 0) {
+            opt.max_burst = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--streams") == 0) {
+            opt.streams = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--phase-writes") == 0) {
+            opt.phase_writes = std::strtoll(value, nullptr, 10); ++i;
+        } else if (std::strcmp(key, "--trim-ratio") == 0) {
+            opt.trim_ratio = std::atof(value); ++i;
+        } else if (std::strcmp(key, "--trim-pages") == 0) {
+            opt.trim_pages = std::atoi(value); ++i;
+        }
+    }
+    if (!(opt.write_ratio >= 0.0 && opt.write_ratio <= 1.0 && opt.hot_access >= 0.0 && opt.hot_access <= 1.0)) {
+        std::cerr << "Workload Error: --write-ratio and --hot-access must be in [0, 1]." << std::endl;
+        return false;
+    }
+    if (!(opt.hot_fraction > 0.0 && opt.hot_fraction < 1.0)) {
+        std::cerr << "Workload Error: --hot-fraction must be in (0, 1)." << std::endl;
+        return false;
+    }
+    if (!(opt.zipf_theta >= 0.0 && std::isfinite(opt.zipf_theta))) { // NaN이면 Zipf 샘플러의 거절 루프가 끝나지 않음
+        std::cerr << "Workload Error: --zipf-theta must be a finite number of at least 0." << std::endl;
+        return false;
+    }
+    if (opt.min_burst < 1 || opt.max_burst < opt.min_burst) {
+        std::cerr << "Workload Error: --burst-min must be at least 1 and --burst-max at least --burst-min." << std::endl;
+        return false;
+    }
+    if (opt.streams < 1 || opt.phase_writes < 1) {
+        std::cerr << "Workload Error: --streams and --phase-writes must be at least 1." << std::endl;
+        return false;
+    }
+    if (!(opt.trim_ratio >= 0.0 && opt.write_ratio + opt.trim_ratio <= 1.0) || opt.trim_pages < 1) {
+        std::cerr << "Workload Error: --trim-ratio must be in [0, 1 - write ratio] and --trim-pages at least 1." << std::endl;
+        return false;
+    }
+    static const char* const KINDS[] = {"uniform", "hotcold", "zipf", "bursty", "sequential", "phase"};
+    for (const char* kind : KINDS) {
+        if (opt.kind == kind) return true;
+    }
+    std::cerr << "Workload Error: unknown workload '" << opt.kind << "'." << std::endl;
+    return false;
+}
+
+inline std::unique_ptr<Workload> make_workload_kind(const WorkloadOptions& opt, int64_t num_lpns, const Rng& rng) {
+    if (opt.kind == "uniform") {
+        return std::unique_ptr<Workload>(new UniformWorkload(num_lpns, opt.write_ratio, rng));
+    } else if (opt.kind == "zipf") {
+        return std::unique_ptr<Workload>(new ZipfWorkload(num_lpns, opt.write_ratio, rng, opt.zipf_theta));
+    } else if (opt.kind == "bursty") {
+        return std::unique_ptr<Workload>(new BurstyWorkload(num_lpns, opt.write_ratio, rng, opt.hot_fraction,
+                                                            opt.min_burst, opt.max_burst));
+    } else if (opt.kind == "sequential") {
+        return std::unique_ptr<Workload>(new SequentialWorkload(num_lpns, opt.write_ratio, rng, opt.streams));
+    } else if (opt.kind == "phase") {
+        return std::unique_ptr<Workload>(new PhaseShiftWorkload(num_lpns, opt.write_ratio, rng, opt.hot_fraction,
+                                                                opt.hot_access, opt.phase_writes));
+    }
+    return std::unique_ptr<Workload>(new HotColdWorkload(num_lpns, opt.write_ratio, rng, opt.hot_fraction,
+                                                         opt.hot_access));
+}
+
+inline std::unique_ptr<Workload> make_workload(const WorkloadOptions& opt, int64_t num_lpns, const Rng& rng) {
+    std::unique_ptr<Workload> workload = make_workload_kind(opt, num_lpns, rng);
+    workload->set_host_streams(opt.host_streams);
+    workload->set_trim(opt.trim_ratio, opt.trim_pages);
+    return workload;
+}
+
+#endif // WORKLOAD_H
@@ -0,0 +1,282 @@
+#ifndef WRITE_BUFFER_H
+#define WRITE_BUFFER_H
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Geometry.h"
+#include "NandFlash.h"
+#include "GcSchedule.h"
+
+// FTL 앞단의 DRAM 쓰기 버퍼 (write-back)
+// - 호스트 쓰기는 버퍼에만 기록하고, 같은 LPN을 다시 쓰면 버퍼 안에서 덮어씀 (NAND 쓰기 없음)
+// - 버퍼가 꽉 차면 교체 정책으로 flush_batch개 페이지를 골라 한 번에 FTL로 내려보냄
+// - 읽기는 버퍼에 있으면 버퍼에서 바로 응답
+// - 교체 정책: LRU (읽기/쓰기 적중 시 가장 최근으로), FIFO (들어온 순서대로), CLOCK (참조 비트 + 시계 바늘)
+
+enum class BufferPolicy {
+    LRU,
+    FIFO,
+    CLOCK
+};
+
+struct WriteBufferOptions {
+    int capacity;       // 버퍼 크기 (페이지 수, 0이면 버퍼 없음)
+    BufferPolicy policy;
+    int flush_batch;    // 꽉 찼을 때 한 번에 내려보내는 페이지 수
+
+    WriteBufferOptions() : capacity(0), policy(BufferPolicy::LRU), flush_batch(16) {}
+};
+
+inline const char* buffer_policy_name(BufferPolicy policy) {
+    switch (policy) {
+    case BufferPolicy::LRU: return "lru";
+    case BufferPolicy::FIFO: return "fifo";
+    case BufferPolicy::CLOCK: return "clock";
+    }
+    return "?";
+}
+
+// 명령행 인자에서 쓰기 버퍼 설정을 읽음 (모르는 인자는 건너뜀)
+//   --buffer-pages N  --buffer-policy lru|fifo|clock  --buffer-flush N
+inline bool parse_buffer_args(int argc, char** argv, WriteBufferOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        const char* key = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(key, "--buffer-pages") == 0) {
+            opt.capacity = std::atoi(value); ++i;
+        } else if (std::strcmp(key, "--buffer-policy") == 0) {
+            std::string policy = value;
+            if (policy == "lru") opt.policy = BufferPolicy::LRU;
+            else if (policy == "fifo") opt.policy = BufferPolicy::FIFO;
+            else if (policy == "clock") opt.policy = BufferPolicy::CLOCK;
+            else {
+                std::cerr << "Buffer Error: unknown policy '" << policy << "' (lru | fifo | clock)." << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (std::strcmp(key, "--buffer-flush") == 0) {
+            opt.flush_batch = std::atoi(value); ++i;
+        }
+    }
+    if (opt.capacity < 0 || opt.flush_batch < 1) {
+        std::cerr << "Buffer Error: --buffer-pages must not be negative and --buffer-flush must be at least 1." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 버퍼 본체 (슬롯 배열 + LPN -> 슬롯 해시)
+// - 슬롯마다 LPN, 스트림 힌트, CLOCK 참조 비트, LRU/FIFO 순서용 이중 연결 리스트 링크
+// - 빈 슬롯은 별도 스택으로 관리
+class WriteBuffer {
+public:
+    explicit WriteBuffer(const WriteBufferOptions& opt)
+        : opt_(opt), lpn_(opt.capacity), stream_(opt.capacity), ref_(opt.capacity, 0),
+          next_(opt.capacity, NONE), prev_(opt.capacity, NONE), head_(NONE), tail_(NONE), hand_(0),
+          write_hits_(0), read_hits_(0), flushes_(0), flushed_pages_(0), discarded_(0) {
+        slot_of_.reserve(opt.capacity);
+        for (int s = opt.capacity - 1; s >= 0; --s) free_.push_back(s);
+    }
+
+    bool enabled() const { return opt_.capacity > 0; }
+    int size() const { return static_cast<int>(slot_of_.size()); }
+
+    // 쓰기를 버퍼에 넣음. 자리가 없으면 먼저 flush_batch개를 sink.write(lpn, stream)으로 내려보냄
+    // (sink가 실패하면 false)
+    template <typename Sink>
+    bool write(Lpn lpn, int stream, Sink& sink) {
+        std::unordered_map<Lpn, int>::iterator it = slot_of_.find(lpn);
+        if (it != slot_of_.end()) {
+            write_hits_++;
+            stream_[it->second] = stream;
+            touch(it->second);
+            return true;
+        }
+        if (free_.empty() && !flush(opt_.flush_batch, sink)) return false;
+        int slot = free_.back();
+        free_.pop_back();
+        lpn_[slot] = lpn;
+        stream_[slot] = stream;
+        ref_[slot] = 0;
+        link_tail(slot);
+        slot_of_[lpn] = slot;
+        return true;
+    }
+
+    // 버퍼에 있으면 적중 (LRU/CLOCK은 참조로 기록)
+    bool read(Lpn lpn) {
+        std::unordered_map<Lpn, int>::iterator it = slot_of_.find(lpn);
+        if (it == slot_of_.end()) return false;
+        read_hits_++;
+        touch(it->second);
+        return true;
+    }
+
+    // TRIM된 페이지는 내려보내지 않고 버림 (있었으면 true)
+    bool discard(Lpn lpn) {
+        std::unordered_map<Lpn, int>::iterator it = slot_of_.find(lpn);
+        if (it == slot_of_.end()) return false;
+        int slot = it->second;
+        unlink(slot);
+        slot_of_.erase(it);
+        free_.push_back(slot);
+        discarded_++;
+        return true;
+    }
+
+    // 교체 정책 순서대로 최대 n개를 내려보냄
+    template <typename Sink>
+    bool flush(int n, Sink& sink) {
+        if (slot_of_.empty()) return true;
+        flushes_++;
+        for (int k = 0; k < n && !slot_of_.empty(); ++k) {
+            int slot = pick_victim();
+            unlink(slot);
+            slot_of_.erase(lpn_[slot]);
+            free_.push_back(slot);
+            flushed_pages_++;
+            if (!sink.write(lpn_[slot], stream_[slot])) return false;
+        }
+        return true;
+    }
+
+    long long write_hits() const { return write_hits_; }
+    long long read_hits() const { return read_hits_; }
+    long long flushes() const { return flushes_; }
+    long long flushed_pages() const { return flushed_pages_; }
+    long long discarded() const { return discarded_; }
+
+private:
+    static constexpr int NONE = -1;
+
+    void touch(int slot) {
+        if (opt_.policy == BufferPolicy::LRU) {
+            unlink(slot);
+            link_tail(slot);
+        } else if (opt_.policy == BufferPolicy::CLOCK) {
+            ref_[slot] = 1;
+        }
+    }
+
+    int pick_victim() {
+        if (opt_.policy != BufferPolicy::CLOCK) return head_;
+        // 시계 바늘이 슬롯 배열을 돌면서 참조 비트가 0인 사용 중 슬롯을 찾음 (지나가며 비트를 지움)
+        while (true) {
+            int slot = hand_;
+            hand_ = hand_ + 1 == opt_.capacity ? 0 : hand_ + 1;
+            if (!in_use(slot)) continue;
+            if (ref_[slot]) {
+                ref_[slot] = 0;
+                continue;
+            }
+            return slot;
+        }
+    }
+
+    bool in_use(int slot) const { return prev_[slot] != NONE || head_ == slot; }
+
+    void link_tail(int slot) {
+        prev_[slot] = tail_;
+        next_[slot] = NONE;
+        if (tail_ != NONE) next_[tail_] = slot; else head_ = slot;
+        tail_ = slot;
+    }
+
+    void unlink(int slot) {
+        if (prev_[slot] != NONE) next_[prev_[slot]] = next_[slot]; else head_ = next_[slot];
+        if (next_[slot] != NONE) prev_[next_[slot]] = prev_[slot]; else tail_ = prev_[slot];
+        prev_[slot] = next_[slot] = NONE;
+    }
+
+    WriteBufferOptions opt_;
+    std::vector<Lpn> lpn_;
+    std::vector<int> stream_;
+    std::vector<uint8_t> ref_;
+    std::vector<int> next_, prev_; // 들어온 순서(FIFO) / 최근 사용 순서(LRU) 리스트, CLOCK에서는 사용 중 표시
+    int head_, tail_;
+    int hand_;
+    std::vector<int> free_;
+    std::unordered_map<Lpn, int> slot_of_;
+
+    long long write_hits_;
+    long long read_hits_;
+    long long flushes_;
+    long long flushed_pages_;
+    long long discarded_;
+};
+
+// 쓰기 버퍼를 붙인 FTL (FtlT와 같은 인터페이스, 용량이 0이면 그대로 통과)
+// - WAF는 호스트 쓰기 기준 (버퍼가 흡수한 쓰기도 분모에 들어감, 아직 버퍼에 남은 페이지는 NAND에 쓰지 않은 것으로 셈)
+// - params.buffer로 버퍼를 설정하고 나머지 params는 FtlT에 그대로 넘김
+template <typename FtlT>
+class BufferedFtl {
+public:
+    template <typename Params>
+    BufferedFtl(const Geometry& geo, const Params& params)
+        : ftl_(geo, params), buffer_(params.buffer), host_writes_(0), host_reads_(0) {}
+
+    template <typename Params>
+    static long long metadata_bytes_for(const Geometry& geo, const Params& params) {
+        return FtlT::metadata_bytes_for(geo, params) + static_cast<long long>(params.buffer.capacity) * geo.page_size;
+    }
+    template <typename Params>
+    static int num_streams_for(const Params& params) { return FtlT::num_streams_for(params); }
+
+    bool write(Lpn lpn, int stream_hint = -1) {
+        host_writes_++;
+        if (!buffer_.enabled()) return ftl_.write(lpn, stream_hint);
+        return buffer_.write(lpn, stream_hint, ftl_);
+    }
+
+    // 버퍼에 있는 페이지는 NAND에 쓰지 않고 버린 뒤 FTL에도 TRIM을 넘김 (예전 복사본이 NAND에 있을 수 있음)
+    // (논리 용량 밖이거나 빈 구간이면 버퍼도 건드리지 않음)
+    bool trim(Lpn lpn, int count) {
+        const int64_t n = ftl_.num_logical_pages();
+        if (lpn < 0 || lpn >= n || count <= 0) return true;
+        if (buffer_.enabled()) {
+            for (Lpn l = lpn; l < lpn + count && l < n; ++l) buffer_.discard(l);
+        }
+        return ftl_.trim(lpn, count);
+    }
+
+    void read(Lpn lpn) {
+        host_reads_++;
+        if (buffer_.enabled() && buffer_.read(lpn)) return;
+        ftl_.read(lpn);
+    }
+
+    double getWAF() const {
+        return host_writes_ == 0 ? 0.0 : static_cast<double>(ftl_.nand_writes()) / host_writes_;
+    }
+
+    // 아래는 내부 FTL에 그대로 위임
+    int idle() { return ftl_.idle(); }
+    void set_nand_op_log(std::vector<NandOp>* log) { ftl_.set_nand_op_log(log); }
+    const Geometry& geometry() const { return ftl_.geometry(); }
+    const GcSchedule& gc_schedule() const { return ftl_.gc_schedule(); }
+    int64_t num_logical_pages() const { return ftl_.num_logical_pages(); }
+    long long trimmed_pages() const { return ftl_.trimmed_pages(); }
+    long long gc_count() const { return ftl_.gc_count(); }
+    long long victims_examined() const { return ftl_.victims_examined(); }
+    const NandFlash& nand() const { return ftl_.nand(); }
+
+    // 버퍼에 남은 페이지를 모두 FTL로 내려보냄 (스냅샷 저장 전)
+    bool flush_buffer() { return buffer_.flush(buffer_.size(), ftl_); }
+
+    const WriteBuffer& buffer() const { return buffer_; }
+    long long host_writes() const { return host_writes_; }
+    long long host_reads() const { return host_reads_; }
+    FtlT& ftl() { return ftl_; }
+
+private:
+    FtlT ftl_;
+    WriteBuffer buffer_;
+    long long host_writes_;
+    long long host_reads_;
+};
+
+#endif // WRITE_BUFFER_H
@@ -0,0 +1,824 @@
+// SSD FTL 시뮬레이터 (단일 실행 파일)
+//
+// 빌드: g++ -O2 -std=c++17 -pthread -o simulator simulator/main.cpp core/NandFlash.cpp
+//
+// FTL 조합 선택 (--ftl 로 기본 조합을 고르고, 나머지 옵션으로 정책을 하나씩 바꿀 수 있음)
+//   --ftl greedy|hotcold|hybrid     greedy  = none + greedy + fresh
+//                                   hotcold = write-count + hot-first + spill (기본값)
+//                                   hybrid  = 로그 블록 FTL (--hybrid bast|fast --log-blocks N, core/HybridFtl.h)
+//   --classifier none|write-count|decay|count-min|host   --placement fresh|spill|gc-stream
+//   (decay / count-min은 고정 메모리 감쇠 온도 추적기, 설정은 core/Hotness.h 참고)
+//   --host-streams N                 host 분류기가 쓰는 호스트 스트림 수 (워크로드가 쓰기마다 힌트를 붙임, 기본값 4)
+//   --victim greedy|hot-first|oldest-hot|cost-benefit|cat|windowed|d-choices
+//   --buffer-pages N --buffer-policy lru|fifo|clock   FTL 앞단 DRAM 쓰기 버퍼 (core/WriteBuffer.h, 기본값 0 = 없음)
+//   --cmt-entries N | --cmt-bytes B   DFTL 요구 페이징 매핑 (core/DemandMapping.h, 기본값 0 = L2P 전체를 DRAM에)
+//   --alloc fifo|min-erase --wl-threshold N   빈 블록 할당 순서와 정적 웨어 레벨링 (core/WearLeveling.h)
+//   --trim-ratio R --trim-pages N     요청 중 TRIM 비율과 TRIM 한 번의 최대 페이지 수 (core/Workload.h, 기본값 0 = TRIM 없음)
+//   --compare greedy|hotcold          같은 실행 난수(공통 난수)로 기준 프리셋도 돌려 짝지은 WAF 차이와 신뢰 구간을 보고
+//   --runs N --ci-half-width X       최대 실행 수 (기본값 300), 평균 WAF(비교면 차이)의 95% 신뢰 구간 반폭이 X 이하면 멈춤
+//   --ops N                          실행 하나의 요청 수 (기본값 50000, 정상 상태 조기 종료를 켜면 상한)
+//   --waf-window N --steady-precision X   창 단위 WAF로 정상 상태를 찾아 그 구간만 보고 (core/SteadyState.h)
+//   --precondition none|fill|random  측정 전에 장치를 순차로 채우고 (random이면) WAF가 안정될 때까지 덮어씀 (core/Precondition.h)
+//   --save-snapshot PATH --load-snapshot PATH   첫 실행이 끝난 장치 상태를 저장 / 모든 실행을 저장된 상태에서 시작 (core/Snapshot.h)
+//   --gc-hard N                      이 개수보다 빈 블록이 적으면 쓰기 전에 GC (hard 워터마크, 기본값 5, core/GcSchedule.h)
+//   --sweep NAME=V1,V2,... [--sweep-random N] [--sweep-out PATH]   옵션 값들의 격자 / 무작위 탐색을 병렬로 돌려
+//                                    점마다 WAF, 지우기 횟수, 처리량을 CSV 또는 JSON 표 하나로 씀 (core/Sweep.h)
+
+#include <iostream>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <iomanip>
+#include <cstring>
+#include <string>
+#include <chrono>
+#include "../core/MonteCarlo.h"
+#include "../core/Workload.h"
+#include "../core/TraceReplay.h"
+#include "../core/Timing.h"
+#include "../core/FtlPolicies.h"
+#include "../core/WriteBuffer.h"
+#include "../core/WearLeveling.h"
+#include "../core/Snapshot.h"
+#include "../core/Precondition.h"
+#include "../core/SteadyState.h"
+#include "../core/Statistics.h"
+#include "../core/Sweep.h"
+
+// 실행할 FTL 정책 조합 (이름으로 보관했다가 dispatch에서 템플릿 인스턴스로 바꿈)
+struct FtlOptions {
+    std::string mapping; // page (페이지 매핑 Ftl) | hybrid (HybridFtl, 아래 정책들은 쓰지 않음)
+    std::string classifier;
+    std::string victim;
+    std::string placement;
+    int host_streams;
+    std::string compare; // 비어 있지 않으면 같은 난수로 이 프리셋(greedy | hotcold)도 돌려 짝지은 WAF 차이를 보고
+
+    FtlOptions() : mapping("page"), classifier("write-count"), victim("hot-first"), placement("spill"), host_streams(4) {}
+};
+
+// 명령행 인자에서 FTL 조합을 읽음 (--ftl 프리셋을 먼저 적용하고 개별 정책 옵션으로 덮어씀)
+bool parse_ftl_args(int argc, char** argv, FtlOptions& opt) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--ftl") == 0) {
+            std::string preset = argv[i + 1];
+            if (preset == "greedy") {
+                opt.mapping = "page"; opt.classifier = "none"; opt.victim = "greedy"; opt.placement = "fresh";
+            } else if (preset == "hotcold") {
+                opt.mapping = "page"; opt.classifier = "write-count"; opt.victim = "hot-first"; opt.placement = "spill";
+            } else if (preset == "hybrid") {
+                opt.mapping = "hybrid";
+            } else {
+                std::cerr << "FTL Error: unknown preset '" << preset << "' (greedy | hotcold | hybrid)." << std::endl;
+                return false;
+            }
+        }
+    }
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--classifier") == 0) {
+            opt.classifier = argv[++i];
+        } else if (std::strcmp(argv[i], "--victim") == 0) {
+            opt.victim = argv[++i];
+        } else if (std::strcmp(argv[i], "--placement") == 0) {
+            opt.placement = argv[++i];
+        } else if (std::strcmp(argv[i], "--host-streams") == 0) {
+            opt.host_streams = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--compare") == 0) {
+            opt.compare = argv[++i];
+        }
+    }
+    if (!opt.compare.empty() && opt.compare != "greedy" && opt.compare != "hotcold") {
+        std::cerr << "FTL Error: unknown baseline '" << opt.compare << "' for --compare (greedy | hotcold)." << std::endl;
+        return false;
+    }
+    if (opt.host_streams < 1 || opt.host_streams > 255) {
+        std::cerr << "FTL Error: --host-streams must be between 1 and 255." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 시뮬레이션 한 번의 결과
+struct RunResult {
+    double waf;
+    long long gc_count;         // GC 횟수
+    long long victims_examined; // 희생양을 고르며 살펴본 후보 수 (GC CPU 비용 지표)
+    TimingStats timing;         // --timing일 때만 채워짐
+    long long host_writes, host_reads;
+    long long trimmed_pages;
+    long long buffer_write_hits, buffer_read_hits; // 쓰기 버퍼가 흡수한 쓰기 / 버퍼에서 응답한 읽기
+    long long buffer_flushes, buffer_flushed_pages;
+    long long cmt_hits, cmt_misses;                 // DFTL일 때만 0이 아님
+    long long translation_reads, translation_writes;
+    long long switch_merges, partial_merges, full_merges; // 혼합 FTL일 때만 0이 아님
+    long long merge_copies;
+    long long nand_writes;
+    long long wl_blocks, wl_pages;        // 정적 웨어 레벨링이 비운 블록 / 옮긴 페이지
+    std::vector<long long> erase_hist;    // 실행이 끝났을 때 블록별 지우기 횟수 히스토그램
+    PreconditionResult precondition;      // 측정 전 길들이기 (통계에는 들어가지 않음)
+    bool steady;                          // --waf-window일 때: 정상 상태에 닿았는지
+    bool stopped_early;                   // 정밀도를 채워 요청 수 상한 전에 멈췄는지
+    long long ops;                        // 실제로 실행한 요청 수
+    long long warmup_writes;              // 정상 상태 전까지의 호스트 쓰기 (WAF에서 뺌)
+    int windows;                          // 기록한 창 수
+    double baseline_waf;                  // --compare일 때: 같은 난수로 돌린 기준 FTL의 WAF
+};
+
+// 매핑 방식별 통계를 결과에 옮겨 담음 (페이지 매핑 FTL: DFTL 통계, 혼합 FTL: 병합 통계)
+template <typename C, typename V, typename P>
+void collect_mapping_stats(Ftl<C, V, P>& ftl, RunResult& result) {
+    result.cmt_hits = ftl.cmt_hits();
+    result.cmt_misses = ftl.cmt_misses();
+    result.translation_reads = ftl.translation_reads();
+    result.translation_writes = ftl.translation_writes();
+    result.switch_merges = result.partial_merges = result.full_merges = result.merge_copies = 0;
+    result.wl_blocks = ftl.wl_blocks();
+    result.wl_pages = ftl.wl_pages();
+}
+
+void collect_mapping_stats(HybridFtl& ftl, RunResult& result) {
+    result.cmt_hits = result.cmt_misses = result.translation_reads = result.translation_writes = 0;
+    result.switch_merges = ftl.switch_merges();
+    result.partial_merges = ftl.partial_merges();
+    result.full_merges = ftl.full_merges();
+    result.merge_copies = ftl.merge_copies();
+    result.wl_blocks = result.wl_pages = 0;
+}
+
+// 스냅샷 저장/불러오기 (페이지 매핑 FTL만 지원, 혼합 FTL은 run_simulation에서 미리 거름)
+// 불러온 뒤에는 통계를 0부터 다시 세서 이번 실행 구간만 측정
+template <typename C, typename V, typename P>
+bool save_ftl_snapshot(const Ftl<C, V, P>& ftl, const std::string& path) {
+    return ftl.save(path.c_str());
+}
+
+bool save_ftl_snapshot(const HybridFtl&, const std::string&) { return false; }
+
+template <typename C, typename V, typename P>
+SnapshotLoad load_ftl_snapshot(Ftl<C, V, P>& ftl, const SnapshotReader& reader) {
+    SnapshotLoad how = ftl.load(reader);
+    ftl.reset_stats();
+    return how;
+}
+
+SnapshotLoad load_ftl_snapshot(HybridFtl&, const SnapshotReader&) { return SnapshotLoad::FAILED; }
+
+// 지우기 횟수 히스토그램을 구간 8개 정도로 묶어 출력 (모든 실행의 블록을 합친 비율)
+void print_erase_histogram(const std::vector<long long>& hist, std::ostream& out) {
+    EraseCountSummary all = summarize_erase_counts(hist);
+    long long total = std::accumulate(hist.begin(), hist.end(), 0LL);
+    if (total == 0) return;
+    const int width = (all.max - all.min) / 8 + 1;
+    out << "Erase count histogram (all runs):" << std::endl;
+    for (int lo = all.min; lo <= all.max; lo += width) {
+        long long n = 0;
+        for (int c = lo; c < lo + width && c <= all.max; ++c) n += hist[c];
+        double pct = 100.0 * n / total;
+        out << "  " << std::setw(5) << lo << " - " << std::setw(5) << lo + width - 1 << ": "
+            << std::setw(9) << pct << "% " << std::string(static_cast<size_t>(pct / 2 + 0.5), '#') << std::endl;
+    }
+}
+
+// 실행 하나에 필요한 설정 (run_simulation이 채우고 simulate_run은 읽기만 함)
+struct RunSetup {
+    const Geometry& geo;
+    const FtlParams& params;
+    const WorkloadOptions& wopt;
+    const PreconditionOptions& popt;
+    const SnapshotOptions& sopt;
+    const SnapshotReader& snapshot;
+    const SteadyStateOptions& ssopt;
+    const TimingConfig& tcfg;
+    long long ops;
+};
+
+// 실행 sim 하나를 FtlT로 돌려 result를 채움
+// rng는 실행 번호의 난수 스트림 사본이라 워크로드, GC 시드, 길들이기 수열이 FtlT와 관계없이 같음
+// (--compare의 기준 FTL은 같은 rng로 한 번 더 돌림 = 공통 난수로 짝지은 비교, primary가 false)
+template <typename FtlT>
+void simulate_run(const RunSetup& s, int sim, Rng rng, bool primary, RunResult& result) {
+    const char* tag = primary ? "" : " (baseline)";
+    std::unique_ptr<Workload> workload = make_workload(s.wopt, s.geo.logical_pages(), rng);
+    FtlParams run_params = s.params;
+    run_params.gc_seed = rng.next(); // 워크로드는 rng 사본을 가지므로 워크로드 수열은 그대로
+    FtlT ftl(s.geo, run_params);
+    const GcSchedule& sched = ftl.gc_schedule();
+    if (s.sopt.loading()) {
+        load_ftl_snapshot(ftl.ftl(), s.snapshot); // run_simulation이 같은 설정으로 미리 불러 봤으므로 실패하지 않음
+    }
+    if (s.popt.enabled()) {
+        Rng pre_rng(rng.next(), static_cast<uint64_t>(sim)); // 켰을 때만 뽑으므로 끈 실행의 결과는 그대로
+        if (!precondition(ftl.ftl(), s.popt, pre_rng, result.precondition)) {
+            std::cout << "\n--- Simulation " << sim + 1 << tag << " stopped during preconditioning ---" << std::endl;
+        }
+        ftl.ftl().reset_stats();
+    }
+
+    // 길들이지 않은 장치는 논리 용량을 한 번 다 쓸 때까지 GC가 없으므로 그 전에는 정상 상태를 찾지 않음
+    SteadyStateTracker tracker(s.ssopt, s.popt.enabled() || s.sopt.loading() ? 0 : s.geo.logical_pages());
+    result.ops = s.ops;
+    result.stopped_early = false;
+    if (s.tcfg.enabled) {
+        if (!run_timed(ftl, *workload, s.ops, s.tcfg, result.timing)) {
+            std::cout << "\n--- Simulation " << sim + 1 << tag << " stopped due to a fatal error ---" << std::endl;
+        }
+    } else {
+        for (long long i = 0; i < s.ops; ++i) {
+            const Op& op = workload->next();
+            if (op.type == OpType::WRITE) {
+                if (!ftl.write(op.lpn, op.stream)) {
+                    std::cout << "\n--- Simulation " << sim + 1 << tag << " stopped due to a fatal error at operation " << i + 1 << " ---" << std::endl;
+                    break;
+                }
+            } else if (op.type == OpType::TRIM) {
+                if (!ftl.trim(op.lpn, op.count)) {
+                    std::cout << "\n--- Simulation " << sim + 1 << tag << " stopped due to a fatal error at operation " << i + 1 << " ---" << std::endl;
+                    break;
+                }
+            } else {
+                ftl.read(op.lpn);
+            }
+            if (sched.idle_every > 0 && (i + 1) % sched.idle_every == 0) {
+                ftl.idle(); // 호스트가 쉬는 구간 (BACKGROUND 모드에서만 GC)
+            }
+            if (s.ssopt.enabled() && tracker.sample(ftl.host_writes(), ftl.ftl().nand_writes())) {
+                result.ops = i + 1;
+                result.stopped_early = i + 1 < s.ops;
+                break;
+            }
+        }
+    }
+
+    // 정상 상태 판정을 켜면 워밍업 창을 뺀 구간의 WAF, 아니면 실행 전체의 WAF
+    result.waf = s.ssopt.enabled() ? tracker.steady_waf() : ftl.getWAF();
+    result.steady = tracker.steady();
+    result.warmup_writes = tracker.warmup_host_writes();
+    result.windows = tracker.num_windows();
+    result.gc_count = ftl.gc_count();
+    result.victims_examined = ftl.victims_examined();
+    result.host_writes = ftl.host_writes();
+    result.host_reads = ftl.host_reads();
+    result.trimmed_pages = ftl.trimmed_pages();
+    result.buffer_write_hits = ftl.buffer().write_hits();
+    result.buffer_read_hits = ftl.buffer().read_hits();
+    result.buffer_flushes = ftl.buffer().flushes();
+    result.buffer_flushed_pages = ftl.buffer().flushed_pages();
+    collect_mapping_stats(ftl.ftl(), result);
+    result.nand_writes = ftl.ftl().nand_writes();
+    add_erase_histogram(ftl.nand(), result.erase_hist);
+
+    // 버퍼에 남은 페이지를 먼저 내려보낸 뒤 저장 (결과는 이미 모았으므로 통계에는 영향 없음)
+    if (primary && sim == 0 && s.sopt.saving()) {
+        if (!ftl.flush_buffer() || !save_ftl_snapshot(ftl.ftl(), s.sopt.save_path)) {
+            std::cout << "\n--- Simulation 1 could not save the snapshot ---" << std::endl;
+        }
+    }
+}
+
+// 선택된 FTL 인스턴스로 시뮬레이션 전체를 실행 (반환값은 종료 코드)
+// FTL 앞에는 항상 쓰기 버퍼(BufferedFtl)를 붙이고, --buffer-pages가 0이면 그대로 통과
+// 설정과 결과는 out에 출력하고 요약은 summary에 채움 (스윕은 out을 버리고 summary만 씀)
+template <typename Inner>
+int run_simulation(int argc, char** argv, const FtlOptions& fopt, std::ostream& out, SimulationSummary& summary) {
+    typedef BufferedFtl<Inner> FtlT;
+
+    // --- 장치 규격 (명령행에서 변경 가능, 기본값은 128 블록 x 64 페이지, OP 25%) ---
+    Geometry geo;
+    long long mem_budget_bytes = 0; // 0이면 메모리 제한 없음
+    if (!parse_geometry_args(argc, argv, geo, mem_budget_bytes)) {
+        return 1;
+    }
+
+    // --- FTL 설정: GC 스케줄 (--gc 등, 기본값은 hard 워터마크에서만 하는 foreground GC), 호스트 스트림 수 ---
+    FtlParams params;
+    if (!parse_gc_args(argc, argv, params.gc) || !validate_gc_schedule(geo, params.gc)) {
+        return 1;
+    }
+    params.host_streams = fopt.host_streams;
+    if (!parse_hotness_args(argc, argv, params.hotness)) {
+        return 1;
+    }
+    if ((fopt.classifier == "decay" || fopt.classifier == "count-min") && params.hotness.threshold > 15) {
+        std::cerr << "Hotness Error: --hot-threshold must be 1..15 for the 4-bit " << fopt.classifier << " counters." << std::endl;
+        return 1;
+    }
+    if (!parse_buffer_args(argc, argv, params.buffer)) {
+        return 1;
+    }
+    if (!parse_dftl_args(argc, argv, params.dftl) || !validate_dftl(geo, params.dftl)) {
+        return 1;
+    }
+    if (!parse_hybrid_args(argc, argv, params.hybrid)) {
+        return 1;
+    }
+    if (!parse_wear_args(argc, argv, params.wear)) {
+        return 1;
+    }
+    const bool hybrid = fopt.mapping == "hybrid";
+    if (hybrid && !HybridFtl::validate(geo, params)) {
+        return 1;
+    }
+    const GcSchedule& sched = params.gc;
+
+    // --- 측정 전 길들이기 (--precondition) ---
+    PreconditionOptions popt;
+    if (!parse_precondition_args(argc, argv, popt)) {
+        return 1;
+    }
+
+    // --- 스냅샷 (--save-snapshot / --load-snapshot) ---
+    SnapshotOptions sopt;
+    if (!parse_snapshot_args(argc, argv, sopt)) {
+        return 1;
+    }
+    if ((sopt.saving() || sopt.loading()) && hybrid) {
+        std::cerr << "Snapshot Error: snapshots are not supported by the hybrid FTL." << std::endl;
+        return 1;
+    }
+    if (sopt.saving() && sopt.save_path == sopt.load_path) {
+        std::cerr << "Snapshot Error: --save-snapshot must not overwrite the snapshot being loaded." << std::endl;
+        return 1;
+    }
+
+    const long long metadata_bytes = FtlT::metadata_bytes_for(geo, params);
+    if (mem_budget_bytes > 0 && metadata_bytes > mem_budget_bytes) {
+        std::cerr << "Error: FTL metadata needs " << metadata_bytes << " bytes, over the budget of "
+                  << mem_budget_bytes << " bytes." << std::endl;
+        return 1;
+    }
+    const int64_t NUM_LOGICAL_PAGES = geo.logical_pages();
+
+    if (hybrid) {
+        out << "FTL: hybrid log-block " << hybrid_mode_name(params.hybrid.mode) << ", "
+            << params.hybrid.log_blocks << " log blocks" << std::endl;
+    } else {
+        out << "FTL: classifier=" << fopt.classifier << ", victim=" << fopt.victim
+            << ", placement=" << fopt.placement << " (" << FtlT::num_streams_for(params) << " streams)" << std::endl;
+    }
+    out << "Mapping DRAM: " << Inner::mapping_dram_bytes_for(geo, params) << " bytes";
+    if (params.dftl.enabled() && !hybrid) {
+        out << " (DFTL, " << params.dftl.cmt_entries << " cached entries + GTD; full L2P would be "
+            << MappingTable::bytes_for(NUM_LOGICAL_PAGES) << " bytes)";
+    }
+    out << std::endl;
+
+    // --- 트레이스 재생 모드 (--trace): 합성 워크로드 대신 실제 블록 트레이스를 한 번 재생 ---
+    TraceOptions topt;
+    if (!parse_trace_args(argc, argv, topt)) {
+        return 1;
+    }
+    if (topt.enabled()) {
+        if (sopt.saving() || sopt.loading() || popt.enabled()) {
+            std::cerr << "Error: snapshots and preconditioning are only supported with synthetic workloads." << std::endl;
+            return 1;
+        }
+        return run_trace_replay<FtlT>(topt, geo, params);
+    }
+
+    // --- 병렬 실행 설정 (--seed, --threads, --ops) ---
+    MonteCarloOptions mc;
+    if (!parse_monte_carlo_args(argc, argv, mc)) {
+        return 1;
+    }
+
+    // --- 정상 상태 판정 (--waf-window 등, 켜면 워밍업을 뺀 구간의 WAF를 보고) ---
+    SteadyStateOptions ssopt;
+    if (!parse_steady_state_args(argc, argv, ssopt)) {
+        return 1;
+    }
+
+    // --- 워크로드 설정 (--workload 등, 기본값은 80% 쓰기 + 90/10 Hot/Cold) ---
+    WorkloadOptions wopt;
+    if (!parse_workload_args(argc, argv, wopt)) {
+        return 1;
+    }
+    if (fopt.classifier == "host") {
+        wopt.host_streams = fopt.host_streams; // 호스트가 아는 온도로 쓰기마다 스트림 힌트를 붙임
+    }
+
+    // --- 타이밍 모델 (--timing 등, 켜면 IOPS와 지연 시간 분포도 측정) ---
+    TimingConfig tcfg;
+    if (!parse_timing_args(argc, argv, tcfg)) {
+        return 1;
+    }
+    if (tcfg.enabled && ssopt.enabled()) {
+        std::cerr << "Steady State Error: --waf-window is not supported together with --timing." << std::endl;
+        return 1;
+    }
+    if (tcfg.enabled && !fopt.compare.empty()) {
+        std::cerr << "FTL Error: --compare is not supported together with --timing." << std::endl;
+        return 1;
+    }
+
+    const long long TOTAL_OPERATIONS = mc.ops;
+    const int NUM_SIMULATIONS = mc.runs;
+
+    // 스레드마다 FTL 하나씩 동시에 살아있으므로 메모리 한도 안에 들어가도록 스레드 수를 제한
+    int threads = resolve_thread_count(mc.threads, NUM_SIMULATIONS);
+    if (mem_budget_bytes > 0 && metadata_bytes * threads > mem_budget_bytes) {
+        threads = static_cast<int>(mem_budget_bytes / metadata_bytes);
+    }
+    mc.threads = threads;
+
+    out << "Starting " << NUM_SIMULATIONS << " SSD simulations..." << std::endl;
+    out << "Total operations per simulation: " << TOTAL_OPERATIONS << std::endl;
+    out << "Geometry: " << geo.num_blocks << " blocks x " << geo.pages_per_block << " pages, OP "
+        << geo.op_ratio * 100 << "% (" << NUM_LOGICAL_PAGES << " logical pages)" << std::endl;
+    out << "FTL metadata: " << metadata_bytes << " bytes ("
+        << static_cast<double>(metadata_bytes) / geo.physical_pages() << " bytes per simulated page)" << std::endl;
+    out << "Threads: " << threads << ", master seed: " << mc.seed << std::endl;
+    if (mc.ci_half_width > 0) {
+        out << "Stopping rule: 95% CI half-width of the mean " << (fopt.compare.empty() ? "WAF" : "paired WAF difference")
+            << " <= " << mc.ci_half_width << " (after at least " << mc.min_runs << " runs)" << std::endl;
+    }
+    if (!fopt.compare.empty()) {
+        out << "Baseline: " << fopt.compare << " preset on the same random streams (paired comparison)" << std::endl;
+    }
+    out << "Workload: " << wopt.kind << ", " << wopt.write_ratio * 100 << "% writes";
+    if (wopt.trim_ratio > 0) out << ", " << wopt.trim_ratio * 100 << "% trims (up to " << wopt.trim_pages << " pages)";
+    out << std::endl;
+    if (ssopt.enabled()) {
+        out << "Steady state: WAF every " << ssopt.window << " host writes, warm-up cut by MSER (at least "
+            << ssopt.detect << " steady windows)";
+        if (ssopt.precision > 0) out << ", stop at " << ssopt.precision * 100 << "% precision";
+        out << std::endl;
+    }
+    out << "GC: " << gc_mode_name(sched.mode) << ", hard watermark " << sched.hard_free << " free blocks";
+    if (sched.mode != GcMode::FOREGROUND) out << ", soft watermark " << sched.soft_free << " free blocks";
+    out << std::endl;
+    if (params.buffer.capacity > 0) {
+        out << "Write buffer: " << params.buffer.capacity << " pages, " << buffer_policy_name(params.buffer.policy)
+            << ", flush " << params.buffer.flush_batch << " pages at a time" << std::endl;
+    }
+    out << "Wear leveling: " << alloc_policy_name(params.wear.alloc) << " allocation";
+    if (params.wear.static_enabled()) {
+        out << ", static threshold " << params.wear.static_threshold << " erases (checked every "
+            << (params.wear.check_erases > 0 ? params.wear.check_erases : geo.num_blocks) << " erases)";
+    }
+    out << std::endl;
+
+    // 스냅샷은 한 번만 열어 모든 실행이 같이 읽음 (먼저 임시 FTL에 불러 보면서 맞는 스냅샷인지 확인)
+    SnapshotReader snapshot;
+    if (sopt.loading()) {
+        if (!snapshot.open(sopt.load_path.c_str())) {
+            return 1;
+        }
+        FtlT probe(geo, params);
+        SnapshotLoad how = load_ftl_snapshot(probe.ftl(), snapshot);
+        if (how == SnapshotLoad::FAILED) {
+            return 1;
+        }
+        out << "Snapshot: loaded " << sopt.load_path << " ("
+            << (how == SnapshotLoad::EXACT ? "exact state" : "stream layout rebuilt") << ")" << std::endl;
+    }
+    if (popt.enabled()) {
+        out << "Precondition: sequential fill";
+        if (popt.mode == PreconditionMode::RANDOM) {
+            out << " + random overwrite until the window WAF changes by at most " << popt.tolerance * 100
+                << "% (up to " << popt.max_passes << " passes)";
+        }
+        out << std::endl;
+    }
+    if (sopt.saving()) {
+        out << "Snapshot: saving the state after run 1 to " << sopt.save_path << std::endl;
+    }
+    out << "----------------------------------------" << std::endl;
+
+    // 실행마다 독립된 난수 스트림(Rng(seed, sim))을 쓰므로 스레드 수와 관계없이 결과가 같음
+    const RunSetup setup = {geo, params, wopt, popt, sopt, snapshot, ssopt, tcfg, TOTAL_OPERATIONS};
+    auto run_one = [&](int sim, Rng& rng) -> RunResult {
+        RunResult result;
+        simulate_run<FtlT>(setup, sim, rng, true, result);
+        result.baseline_waf = 0.0;
+        if (fopt.compare == "greedy") {
+            RunResult base;
+            simulate_run<BufferedFtl<GreedyFtl> >(setup, sim, rng, false, base);
+            result.baseline_waf = base.waf;
+        } else if (fopt.compare == "hotcold") {
+            RunResult base;
+            simulate_run<BufferedFtl<HotColdFtl> >(setup, sim, rng, false, base);
+            result.baseline_waf = base.waf;
+        }
+        return result;
+    };
+
+    // 결과는 실행 번호 순서대로 하나씩 접어 넣고 버림 (스레드 수나 완료 순서와 관계없이 같은 값)
+    RunningStats waf_stats;                               // WAF 평균/분산 (Welford)
+    P2Quantile waf_p5(0.05), waf_p50(0.5), waf_p95(0.95); // WAF 분위수 (P² 스트리밍 추정)
+    RunningStats baseline_stats, diff_stats;              // --compare: 기준 FTL의 WAF, 짝지은 차이 (이 FTL - 기준)
+    long long total_gc = 0;
+    long long total_examined = 0;
+    long long trimmed_pages = 0;
+    long long host_writes = 0, host_reads = 0, write_hits = 0, read_hits = 0, flushes = 0, flushed_pages = 0;
+    long long cmt_hits = 0, cmt_misses = 0, translation_reads = 0, translation_writes = 0;
+    long long switch_merges = 0, partial_merges = 0, full_merges = 0, merge_copies = 0;
+    long long nand_writes = 0, wl_blocks = 0, wl_pages = 0;
+    long long pre_fill = 0, pre_overwrite = 0, pre_stable = 0;
+    double pre_waf = 0;
+    long long steady_runs = 0, early_runs = 0, total_ops = 0, warmup_writes = 0, windows = 0;
+    double erase_min = 0, erase_max = 0, erase_mean = 0, erase_stddev = 0; // 실행별 요약의 합
+    std::vector<long long> erase_hist;                                     // 모든 실행을 합친 히스토그램
+    TimingStats timing;
+    int runs_done = 0;
+    bool ci_reached = false;
+    auto fold = [&](int, const RunResult& r) -> bool {
+        waf_stats.add(r.waf);
+        waf_p5.add(r.waf);
+        waf_p50.add(r.waf);
+        waf_p95.add(r.waf);
+        if (!fopt.compare.empty()) {
+            baseline_stats.add(r.baseline_waf);
+            diff_stats.add(r.waf - r.baseline_waf);
+        }
+        host_writes += r.host_writes;
+        host_reads += r.host_reads;
+        trimmed_pages += r.trimmed_pages;
+        write_hits += r.buffer_write_hits;
+        read_hits += r.buffer_read_hits;
+        flushes += r.buffer_flushes;
+        flushed_pages += r.buffer_flushed_pages;
+        cmt_hits += r.cmt_hits;
+        cmt_misses += r.cmt_misses;
+        translation_reads += r.translation_reads;
+        translation_writes += r.translation_writes;
+        switch_merges += r.switch_merges;
+        partial_merges += r.partial_merges;
+        full_merges += r.full_merges;
+        merge_copies += r.merge_copies;
+        nand_writes += r.nand_writes;
+        wl_blocks += r.wl_blocks;
+        pre_fill += r.precondition.fill_writes;
+        pre_overwrite += r.precondition.overwrite_writes;
+        pre_stable += r.precondition.stable ? 1 : 0;
+        pre_waf += r.precondition.last_window_waf;
+        steady_runs += r.steady ? 1 : 0;
+        early_runs += r.stopped_early ? 1 : 0;
+        total_ops += r.ops;
+        warmup_writes += r.warmup_writes;
+        windows += r.windows;
+        wl_pages += r.wl_pages;
+        EraseCountSummary es = summarize_erase_counts(r.erase_hist);
+        erase_min += es.min;
+        erase_max += es.max;
+        erase_mean += es.mean;
+        erase_stddev += es.stddev;
+        if (r.erase_hist.size() > erase_hist.size()) erase_hist.resize(r.erase_hist.size(), 0);
+        for (size_t c = 0; c < r.erase_hist.size(); ++c) erase_hist[c] += r.erase_hist[c];
+        timing.merge(r.timing);
+        total_gc += r.gc_count;
+        total_examined += r.victims_examined;
+        runs_done++;
+
+        // 목표 신뢰 구간에 닿으면 새 실행을 멈춤 (비교 모드면 짝지은 차이의 신뢰 구간)
+        const RunningStats& target = fopt.compare.empty() ? waf_stats : diff_stats;
+        ci_reached = mc.ci_half_width > 0 && runs_done >= mc.min_runs && target.half_width() <= mc.ci_half_width;
+        if (runs_done % 100 == 0 || runs_done == NUM_SIMULATIONS || ci_reached) {
+            out << "Simulation " << runs_done << "/" << NUM_SIMULATIONS << " completed." << std::endl;
+        }
+        return !ci_reached;
+    };
+    const auto started = std::chrono::steady_clock::now();
+    run_monte_carlo<RunResult>(NUM_SIMULATIONS, mc, run_one, fold);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    summary.ok = true;
+    summary.runs = runs_done;
+    if (runs_done > 0) {
+        const double runs = static_cast<double>(runs_done);
+        summary.waf_mean = waf_stats.mean();
+        summary.waf_ci = waf_stats.half_width();
+        summary.waf_min = waf_stats.min();
+        summary.waf_max = waf_stats.max();
+        summary.waf_p50 = waf_p50.value();
+        summary.gc_per_run = total_gc / runs;
+        summary.host_writes_per_run = host_writes / runs;
+        summary.nand_writes_per_run = nand_writes / runs;
+        summary.erase_min = erase_min / runs;
+        summary.erase_max = erase_max / runs;
+        summary.erase_mean = erase_mean / runs;
+        summary.erase_stddev = erase_stddev / runs;
+    }
+    summary.seconds = seconds;
+    summary.ops_per_sec = seconds > 0 ? total_ops / seconds : 0.0;
+
+    out << "----------------------------------------" << std::endl;
+    out << "All " << runs_done << " simulations finished!" << std::endl;
+    if (ci_reached) {
+        out << "(stopped early: 95% CI half-width " << (fopt.compare.empty() ? waf_stats : diff_stats).half_width()
+            << " <= " << mc.ci_half_width << ")" << std::endl;
+    }
+    out << "--- WAF Distribution Statistics (" << wopt.kind << ") ---" << std::endl;
+
+    if (runs_done > 0) {
+        double average_waf = waf_stats.mean();
+        double min_waf = waf_stats.min();
+        double max_waf = waf_stats.max();
+
+        out << std::fixed << std::setprecision(5);
+        if (ssopt.enabled()) {
+            const double runs = static_cast<double>(runs_done);
+            out << "Steady state reached:         " << 100.0 * steady_runs / runs << "% of runs, after "
+                << warmup_writes / runs << " warm-up host writes on average (excluded from WAF)" << std::endl;
+            out << "Windows per run:              " << windows / runs << " (" << total_ops / runs << " operations, "
+                << 100.0 * early_runs / runs << "% of runs stopped early)" << std::endl;
+        }
+        out << "Average WAF: " << average_waf << std::endl;
+        out << "Min WAF:     " << min_waf << std::endl;
+        out << "Max WAF:     " << max_waf << std::endl;
+        out << "WAF std dev:                  " << waf_stats.stddev() << " (95% CI of the mean: +/- "
+            << waf_stats.half_width() << ")" << std::endl;
+        out << "WAF quantiles:                p5 " << waf_p5.value() << ", p50 " << waf_p50.value()
+            << ", p95 " << waf_p95.value() << " (P2 streaming estimate)" << std::endl;
+        if (!fopt.compare.empty()) {
+            // 짝짓지 않았다면 두 평균 차이의 신뢰 구간 반폭 (공통 난수로 얼마나 좁아졌는지 비교용)
+            const double unpaired = t_critical_95(runs_done - 1) *
+                std::sqrt((waf_stats.variance() + baseline_stats.variance()) / runs_done);
+            out << "Baseline (" << fopt.compare << ") WAF:" << std::string(fopt.compare.size() < 12 ? 12 - fopt.compare.size() : 0, ' ')
+                << baseline_stats.mean() << " (95% CI of the mean: +/- " << baseline_stats.half_width() << ")" << std::endl;
+            out << "Paired WAF difference:        " << diff_stats.mean() << " +/- " << diff_stats.half_width()
+                << " (95% CI, common random numbers; unpaired would be +/- " << unpaired << ")" << std::endl;
+        }
+        out << "Average GCs per run:          " << static_cast<double>(total_gc) / runs_done << std::endl;
+        out << "Victim candidates per GC:     "
+            << (total_gc > 0 ? static_cast<double>(total_examined) / total_gc : 0.0) << std::endl;
+        if (popt.enabled()) {
+            const double runs = static_cast<double>(runs_done);
+            out << "Precondition per run:         " << pre_fill / runs << " fill + " << pre_overwrite / runs
+                << " overwrite writes";
+            if (popt.mode == PreconditionMode::RANDOM) {
+                out << ", last window WAF " << pre_waf / runs << " (stable in " << 100.0 * pre_stable / runs << "% of runs)";
+            }
+            out << std::endl;
+        }
+        if (wopt.trim_ratio > 0) {
+            out << "Trimmed pages per run:        " << static_cast<double>(trimmed_pages) / runs_done << std::endl;
+        }
+        if (params.buffer.capacity > 0) {
+            out << "Buffer write hit rate:        " << (host_writes > 0 ? static_cast<double>(write_hits) / host_writes : 0.0)
+                << " (absorbed without a NAND write)" << std::endl;
+            out << "Buffer read hit rate:         " << (host_reads > 0 ? static_cast<double>(read_hits) / host_reads : 0.0) << std::endl;
+            out << "Buffer flushes per run:       " << static_cast<double>(flushes) / runs_done
+                << " (" << static_cast<double>(flushed_pages) / runs_done << " pages)" << std::endl;
+        }
+        if (hybrid) {
+            const double runs = static_cast<double>(runs_done);
+            out << "Merges per run:               switch " << switch_merges / runs << ", partial "
+                << partial_merges / runs << ", full " << full_merges / runs << std::endl;
+            out << "Pages copied by merges:       " << merge_copies / runs << " per run ("
+                << (host_writes > 0 ? static_cast<double>(merge_copies) / host_writes : 0.0) << " per host write)" << std::endl;
+        } else if (params.dftl.enabled()) {
+            out << "CMT hit rate:                 "
+                << (cmt_hits + cmt_misses > 0 ? static_cast<double>(cmt_hits) / (cmt_hits + cmt_misses) : 0.0) << std::endl;
+            out << "Translation reads per run:    " << static_cast<double>(translation_reads) / runs_done << std::endl;
+            out << "Translation writes per run:   " << static_cast<double>(translation_writes) / runs_done
+                << " (" << (host_writes > 0 ? static_cast<double>(translation_writes) / host_writes : 0.0)
+                << " per host write)" << std::endl;
+        }
+        {
+            const double runs = static_cast<double>(runs_done);
+            out << "Erase count per block:        min " << erase_min / runs << ", max " << erase_max / runs
+                << ", mean " << erase_mean / runs << ", stddev " << erase_stddev / runs << " (per-run average)" << std::endl;
+            if (params.wear.static_enabled()) {
+                out << "Static WL per run:            " << wl_blocks / runs << " blocks, " << wl_pages / runs << " pages ("
+                    << (nand_writes > 0 ? 100.0 * wl_pages / nand_writes : 0.0) << "% of NAND writes)" << std::endl;
+            }
+            print_erase_histogram(erase_hist, out);
+        }
+        if (tcfg.enabled) {
+            print_timing_stats(timing, tcfg, out);
+        }
+        out << "\n(Data for " << runs_done << " successful runs collected)" << std::endl;
+    }
+
+    return 0;
+}
+
+// --- 정책 이름 -> 템플릿 인스턴스 (정책 하나씩 고정해 나가며 내려감) ---
+
+template <typename C, typename V>
+int dispatch_placement(int argc, char** argv, const FtlOptions& opt, std::ostream& out, SimulationSummary& summary) {
+    if (opt.placement == "fresh") return run_simulation<Ftl<C, V, FreshBlockPlacement> >(argc, argv, opt, out, summary);
+    if (opt.placement == "spill") return run_simulation<Ftl<C, V, SpillPlacement> >(argc, argv, opt, out, summary);
+    if (opt.placement == "gc-stream") return run_simulation<Ftl<C, V, GcStreamPlacement> >(argc, argv, opt, out, summary);
+    std::cerr << "FTL Error: unknown placement '" << opt.placement << "' (fresh | spill | gc-stream)." << std::endl;
+    return 1;
+}
+
+template <typename C>
+int dispatch_victim(int argc, char** argv, const FtlOptions& opt, std::ostream& out, SimulationSummary& summary) {
+    if (opt.victim == "greedy") return dispatch_placement<C, GreedyVictim>(argc, argv, opt, out, summary);
+    if (opt.victim == "hot-first") return dispatch_placement<C, HotFirstVictim>(argc, argv, opt, out, summary);
+    if (opt.victim == "oldest-hot") return dispatch_placement<C, OldestHotVictim>(argc, argv, opt, out, summary);
+    if (opt.victim == "cost-benefit") return dispatch_placement<C, CostBenefitVictim>(argc, argv, opt, out, summary);
+    if (opt.victim == "cat") return dispatch_placement<C, CatVictim>(argc, argv, opt, out, summary);
+    if (opt.victim == "windowed") return dispatch_placement<C, WindowedGreedyVictim<> >(argc, argv, opt, out, summary);
+    if (opt.victim == "d-choices") return dispatch_placement<C, DChoicesVictim<> >(argc, argv, opt, out, summary);
+    std::cerr << "FTL Error: unknown victim policy '" << opt.victim
+              << "' (greedy | hot-first | oldest-hot | cost-benefit | cat | windowed | d-choices)." << std::endl;
+    return 1;
+}
+
+int dispatch_classifier(int argc, char** argv, const FtlOptions& opt, std::ostream& out, SimulationSummary& summary) {
+    if (opt.classifier == "none") return dispatch_victim<SingleStreamClassifier>(argc, argv, opt, out, summary);
+    if (opt.classifier == "write-count") return dispatch_victim<WriteCountClassifier>(argc, argv, opt, out, summary);
+    if (opt.classifier == "decay") return dispatch_victim<DecayingCounterClassifier>(argc, argv, opt, out, summary);
+    if (opt.classifier == "count-min") return dispatch_victim<CountMinClassifier>(argc, argv, opt, out, summary);
+    if (opt.classifier == "host") return dispatch_victim<HostHintClassifier>(argc, argv, opt, out, summary);
+    std::cerr << "FTL Error: unknown classifier '" << opt.classifier
+              << "' (none | write-count | decay | count-min | host)." << std::endl;
+    return 1;
+}
+
+// 명령행 하나로 시뮬레이션을 실행 (FTL 조합을 읽고 템플릿 인스턴스로 내려감)
+int run_configuration(int argc, char** argv, std::ostream& out, SimulationSummary& summary) {
+    FtlOptions fopt;
+    if (!parse_ftl_args(argc, argv, fopt)) {
+        return 1;
+    }
+    if (fopt.mapping == "hybrid") {
+        return run_simulation<HybridFtl>(argc, argv, fopt, out, summary);
+    }
+    return dispatch_classifier(argc, argv, fopt, out, summary);
+}
+
+// 파라미터 스윕 (--sweep): 점마다 명령행에 축 값을 덧붙여 run_configuration을 한 번씩 부름
+// - 점들을 --threads개 스레드에 나눠 동시에 돌리고, 점 안의 실행들은 한 스레드에서 차례로 돌림
+//   (점이 코어 수보다 많은 스윕에서 코어를 고르게 쓰고, 점마다 처리량이 스레드 한 개 기준으로 같아짐)
+// - 점의 출력은 버리고 요약만 모아 표 하나로 씀. 진행 상황은 점 번호 순서대로 출력
+//   (표를 표준 출력에 쓰면 진행 상황은 표준 에러로)
+int run_sweep(int argc, char** argv, const SweepOptions& opt) {
+    SnapshotOptions sopt;
+    TraceOptions topt;
+    if (!parse_snapshot_args(argc, argv, sopt) || !parse_trace_args(argc, argv, topt)) {
+        return 1;
+    }
+    if (sopt.saving() || topt.enabled()) {
+        std::cerr << "Sweep Error: --save-snapshot and --trace are not supported in a sweep." << std::endl;
+        return 1;
+    }
+    MonteCarloOptions mc; // --threads만 씀 (점 안의 실행은 각 점이 같은 --seed로 다시 읽음)
+    if (!parse_monte_carlo_args(argc, argv, mc)) {
+        return 1;
+    }
+    std::vector<std::vector<std::string> > points;
+    if (!sweep_points(opt, points) || points.empty()) {
+        return 1;
+    }
+    const int num_points = static_cast<int>(points.size());
+    std::ostream& log = opt.out_path.empty() ? std::cerr : std::cout;
+    log << "Sweep: " << num_points << (opt.random_points > 0 ? " random" : " grid") << " points over";
+    for (const SweepAxis& axis : opt.axes) log << " --" << axis.name;
+    log << " (" << resolve_thread_count(mc.threads, num_points) << " points at a time)" << std::endl;
+
+    auto run_point = [&](int p, Rng&) -> SimulationSummary {
+        std::vector<std::string> args(argv, argv + argc);
+        for (size_t a = 0; a < opt.axes.size(); ++a) {
+            args.push_back("--" + opt.axes[a].name);
+            args.push_back(points[p][a]);
+        }
+        args.push_back("--threads");
+        args.push_back("1");
+        std::vector<char*> point_argv;
+        for (std::string& arg : args) point_argv.push_back(&arg[0]);
+        point_argv.push_back(nullptr);
+
+        std::ostream discard(nullptr); // 점의 설정/결과 출력은 버림 (설정 오류는 표준 에러에 남음)
+        SimulationSummary summary;
+        run_configuration(static_cast<int>(args.size()), point_argv.data(), discard, summary);
+        return summary;
+    };
+    std::vector<SimulationSummary> results;
+    auto collect = [&](int p, const SimulationSummary& s) -> bool {
+        results.push_back(s);
+        log << "Point " << p + 1 << "/" << num_points << ":";
+        for (size_t a = 0; a < opt.axes.size(); ++a) log << " " << opt.axes[a].name << "=" << points[p][a];
+        if (s.ok) {
+            log << " -> WAF " << s.waf_mean << " (" << s.runs << " runs, " << static_cast<long long>(s.ops_per_sec)
+                << " ops/s)" << std::endl;
+        } else {
+            log << " -> error" << std::endl;
+        }
+        return true;
+    };
+    run_monte_carlo<SimulationSummary>(num_points, mc, run_point, collect);
+
+    if (!write_sweep_table(opt, points, results)) {
+        return 1;
+    }
+    if (!opt.out_path.empty()) {
+        std::cout << "Sweep results written to " << opt.out_path << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    SweepOptions sweep;
+    if (!parse_sweep_args(argc, argv, sweep)) {
+        return 1;
+    }
+    if (sweep.enabled()) {
+        return run_sweep(argc, argv, sweep);
+    }
+    SimulationSummary summary;
+    return run_configuration(argc, argv, std::cout, summary);
+}